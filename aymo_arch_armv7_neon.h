@@ -38,6 +38,8 @@ typedef uint16x8_t aymou16_t;
 typedef int32x4_t aymoi32_t;
 typedef uint32x4_t aymou32_t;
 
+typedef float32x4_t aymof32_t;
+
 
 #ifdef __cplusplus
 }  // extern "C"
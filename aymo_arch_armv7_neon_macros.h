@@ -75,6 +75,8 @@ extern "C" {
 #define vsllv           vshlq_s16
 #define vsrlv(a,b)      (vu2i(vshlq_u16(vi2u(a), vnegq_s16(b))))
 #define vsrav(a,b)      (vshlq_s16((a), vnegq_s16(b)))
+#define vbslli(x,n)     (vreinterpretq_s16_s8(vextq_s8(vdupq_n_s8(0), vreinterpretq_s8_s16(x), (16 - (n)))))  // bytes
+#define vbsrli(x,n)     (vreinterpretq_s16_s8(vextq_s8(vreinterpretq_s8_s16(x), vdupq_n_s8(0), (n))))  // bytes
 
 #define vmullo          vmulq_s16
 
@@ -91,9 +93,14 @@ extern "C" {
 #define vinsertn        vinsertn_s16
 
 #define vgather         vgather_s16
+#define vstoreu         vst1q_s16
 
 #define vhsum           vhsum_s16
 #define vhsums          vhsum
+#define vhsumsq         vhsumsq_s16
+#define vhmaxabs        vhmaxabs_s16
+
+#define vtestf          vtestf_s16
 
 #define vpow2m1lt4      vpow2m1lt4_s16
 #define vpow2lt4        vpow2lt4_s16
@@ -125,8 +132,12 @@ extern "C" {
 #define vvandnot(a,b)   (vbicq_s32((b), (a)))  // ~A & B
 
 #define vvadd           vaddq_s32
+#define vvsub           vsubq_s32
+
+#define vvcmpgt(a,b)    (vreinterpretq_s32_u32(vcgtq_s32((a), (b))))
 
 #define vvsrli(x,n)     (vvu2i(vshrq_n_u32(vvi2u(x), (n))))
+#define vvsrai          vshrq_n_s32
 
 #define vvsllv          vshlq_s32
 
@@ -143,6 +154,26 @@ extern "C" {
 
 #define vvcombine       vcombine_s32
 #define vvpack(a,b)     (vcombine_s16(vmovn_s32(a), vmovn_s32(b)))
+#define vvpacks(a,b)    (vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)))
+
+#define vvunpacklo      vunpacklo
+#define vvunpackhi      vunpackhi
+#define vvslli          vshlq_n_s32
+#define vvmadd          vvmadd_s16
+#define vvhsum          vvhsum_s32
+
+
+#define vfset1          vdupq_n_f32
+#define vfmul           vmulq_f32
+#define vfcvt           vcvtq_f32_s32
+#define vfcvtt          vcvtq_s32_f32
+
+
+#define vloadu          vld1q_s16
+#define vvstoreu        vst1q_s32
+#define vfstoreu        vst1q_f32
+#define vstore24        vstore24_s16
+#define vmix4to2        vmix4to2_s16
 
 
 AYMO_INLINE
@@ -322,6 +353,84 @@ int32_t vhsum_s16(int16x8_t x)
 }
 
 
+// Stores as 24-bit little-endian samples, scaled by 256
+AYMO_INLINE
+void vstore24_s16(uint8_t* p, int16x8_t x)
+{
+    uint16x8_t u = vreinterpretq_u16_s16(x);
+    uint8x8x3_t planes;
+    planes.val[0] = vdup_n_u8(0);
+    planes.val[1] = vmovn_u16(u);
+    planes.val[2] = vshrn_n_u16(u, 8);
+    vst3_u8(p, planes);
+}
+
+
+// Downmixes interleaved a/b/c/d frames into a+c/b+d frames, saturated
+AYMO_INLINE
+int16x8_t vmix4to2_s16(int16x8_t x0, int16x8_t x1)
+{
+    int64x2_t cd0 = vshrq_n_s64(vreinterpretq_s64_s16(x0), 32);
+    int64x2_t cd1 = vshrq_n_s64(vreinterpretq_s64_s16(x1), 32);
+    int32x4_t s0 = vreinterpretq_s32_s16(vqaddq_s16(x0, vreinterpretq_s16_s64(cd0)));
+    int32x4_t s1 = vreinterpretq_s32_s16(vqaddq_s16(x1, vreinterpretq_s16_s64(cd1)));
+    return vreinterpretq_s16_s32(vuzpq_s32(s0, s1).val[0]);
+}
+
+
+// Multiplies 16-bit lanes, then adds adjacent pairs into 32-bit lanes
+AYMO_INLINE
+int32x4_t vvmadd_s16(int16x8_t a, int16x8_t b)
+{
+    int32x4_t lo = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+    int32x4_t hi = vmull_s16(vget_high_s16(a), vget_high_s16(b));
+    return vcombine_s32(
+        vpadd_s32(vget_low_s32(lo), vget_high_s32(lo)),
+        vpadd_s32(vget_low_s32(hi), vget_high_s32(hi))
+    );
+}
+
+
+AYMO_INLINE
+int32_t vvhsum_s32(int32x4_t x)
+{
+    int32x2_t sum32 = vadd_s32(vget_low_s32(x), vget_high_s32(x));
+    return vget_lane_s32(vpadd_s32(sum32, sum32), 0);
+}
+
+
+// Sum of squares, modulo 2^32
+AYMO_INLINE
+uint32_t vhsumsq_s16(int16x8_t x)
+{
+    int32x4_t sq32 = vmull_s16(vget_low_s16(x), vget_low_s16(x));
+    sq32 = vmlal_s16(sq32, vget_high_s16(x), vget_high_s16(x));
+    uint64x2_t sum64 = vpaddlq_u32(vreinterpretq_u32_s32(sq32));
+    return (uint32_t)(vgetq_lane_u64(sum64, 0) + vgetq_lane_u64(sum64, 1));
+}
+
+
+// Maximum absolute value, as unsigned
+AYMO_INLINE
+int vhmaxabs_s16(int16x8_t x)
+{
+    uint16x8_t abs16 = vreinterpretq_u16_s16(vabsq_s16(x));
+    uint16x4_t max16 = vpmax_u16(vget_low_u16(abs16), vget_high_u16(abs16));
+    max16 = vpmax_u16(max16, max16);
+    max16 = vpmax_u16(max16, max16);
+    return vget_lane_u16(max16, 0);
+}
+
+
+// Tests whether all the bits are set
+AYMO_INLINE
+int vtestf_s16(int16x8_t x)
+{
+    uint32x2_t and32 = vand_u32(vreinterpret_u32_s16(vget_low_s16(x)), vreinterpret_u32_s16(vget_high_s16(x)));
+    return ((vget_lane_u32(and32, 0) & vget_lane_u32(and32, 1)) == 0xFFFFFFFFU);
+}
+
+
 // 0 <= x < 4  -->  (1 << (x - 1))  -->  0, 1, 2, 4
 AYMO_INLINE
 int16x8_t vpow2m1lt4_s16(int16x8_t x)
@@ -38,6 +38,8 @@ typedef __m256i aymou16_t;
 typedef __m256i aymoi32_t;
 typedef __m256i aymou32_t;
 
+typedef __m256 aymof32_t;
+
 
 #ifdef __cplusplus
 }  // extern "C"
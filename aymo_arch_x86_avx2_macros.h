@@ -75,6 +75,8 @@ extern "C" {
 #define vsllv            mm256_sllv_epi16
 #define vsrlv            mm256_srlv_epi16
 #define vsrav            mm256_srav_epi16
+#define vbslli          _mm256_bslli_epi128  // bytes, per 128-bit lane
+#define vbsrli          _mm256_bsrli_epi128  // bytes, per 128-bit lane
                         
 #define vmulihi         _mm256_mulhi_epi16
 #define vmuluhi         _mm256_mulhi_epu16
@@ -95,12 +97,21 @@ extern "C" {
 #define vinsertn         mm256_insertn_epi16
                         
 #define vgather          mm256_i16gather_epi16lo
+#define vstoreu(p,x)    (_mm256_storeu_si256((__m256i*)(void*)(p), (x)))
                         
 #define vhsum            mm256_hsum_epi16
 #define vhsums           mm256_hsums_epi16
+#define vhsumsq          mm256_hsumsq_epi16
+#define vhmaxabs         mm256_hmaxabs_epi16
+                        
+#define vtestf(x)       (_mm256_testc_si256((x), vsetf()))
                         
 #define vpow2m1lt4       mm256_pow2m1lt4_epi16
 #define vpow2lt4         mm256_pow2lt4_epi16
+#define vpow16lt4        mm256_pow16lt4_epi16
+#define vsrlvx4lt16      mm256_srlvx4lt16_epi16
+#define vsrlvx12lt16     mm256_srlvx12lt16_epi16
+#define vsrl4subvlt4     mm256_srl4subvlt4_epi16
                         
 #define vunpacklo       _mm256_unpacklo_epi16
 #define vunpackhi       _mm256_unpackhi_epi16
@@ -122,8 +133,12 @@ extern "C" {
 #define vvandnot        vandnot
                         
 #define vvadd           _mm256_add_epi32
+#define vvsub           _mm256_sub_epi32
+
+#define vvcmpgt         _mm256_cmpgt_epi32
                         
 #define vvsrli          _mm256_srli_epi32
+#define vvsrai          _mm256_srai_epi32
                         
 #define vvsllv          _mm256_sllv_epi32
                         
@@ -136,6 +151,26 @@ extern "C" {
 #define vvmullo         _mm256_mullo_epi32
                         
 #define vvpackus        _mm256_packus_epi32
+#define vvpacks          mm256_packs_epi32_lin
+
+#define vvunpacklo(x)   (_mm256_cvtepi16_epi32(_mm256_castsi256_si128(x)))
+#define vvunpackhi(x)   (_mm256_cvtepi16_epi32(_mm256_extracti128_si256((x), 1)))
+#define vvslli          _mm256_slli_epi32
+#define vvmadd          _mm256_madd_epi16
+#define vvhsum           mm256_hsum_epi32
+
+
+#define vfset1          _mm256_set1_ps
+#define vfmul           _mm256_mul_ps
+#define vfcvt           _mm256_cvtepi32_ps
+#define vfcvtt          _mm256_cvttps_epi32
+
+
+#define vloadu(p)       (_mm256_loadu_si256((const __m256i*)(const void*)(p)))
+#define vvstoreu(p,x)   (_mm256_storeu_si256((__m256i*)(void*)(p), (x)))
+#define vfstoreu        _mm256_storeu_ps
+#define vstore24         mm256_store24_epi16
+#define vmix4to2         mm256_mix4to2_epi16
 
 
 AYMO_INLINE
@@ -364,6 +399,70 @@ int mm256_hsums_epi16(__m256i x)
 }
 
 
+// Stores as 24-bit little-endian samples, scaled by 256
+AYMO_INLINE
+void mm256_store24_epi16(uint8_t* p, __m256i x)
+{
+    const __m256i lo_shuffle = _mm256_setr_epi8(
+        -1, 0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1,
+        -1, 0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1
+    );
+    const __m256i hi_shuffle = _mm256_setr_epi8(
+        10, 11, -1, 12, 13, -1, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1,
+        10, 11, -1, 12, 13, -1, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1
+    );
+    __m256i lo = _mm256_shuffle_epi8(x, lo_shuffle);
+    __m256i hi = _mm256_shuffle_epi8(x, hi_shuffle);
+    _mm_storeu_si128((__m128i*)(void*)p, _mm256_castsi256_si128(lo));
+    _mm_storel_epi64((__m128i*)(void*)(p + 16), _mm256_castsi256_si128(hi));
+    _mm_storeu_si128((__m128i*)(void*)(p + 24), _mm256_extracti128_si256(lo, 1));
+    _mm_storel_epi64((__m128i*)(void*)(p + 40), _mm256_extracti128_si256(hi, 1));
+}
+
+
+// Downmixes interleaved a/b/c/d frames into a+c/b+d frames, saturated
+AYMO_INLINE
+__m256i mm256_mix4to2_epi16(__m256i x0, __m256i x1)
+{
+    __m256i s0 = _mm256_adds_epi16(x0, _mm256_srli_epi64(x0, 32));
+    __m256i s1 = _mm256_adds_epi16(x1, _mm256_srli_epi64(x1, 32));
+    __m256i p0 = _mm256_shuffle_epi32(s0, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256i p1 = _mm256_shuffle_epi32(s1, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256i p01 = _mm256_unpacklo_epi64(p0, p1);  // frames 0, 1, 4, 5, 2, 3, 6, 7
+    return _mm256_permute4x64_epi64(p01, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+
+// Sum of squares, modulo 2^32
+AYMO_INLINE
+uint32_t mm256_hsumsq_epi16(__m256i x)
+{
+    __m256i sq32 = _mm256_madd_epi16(x, x);
+    return (uint32_t)mm256_hsum_epi32(sq32);
+}
+
+
+// Packs with signed saturation, keeping lanes in sequence
+AYMO_INLINE
+__m256i mm256_packs_epi32_lin(__m256i a, __m256i b)
+{
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+}
+
+
+// Maximum absolute value, as unsigned
+AYMO_INLINE
+int mm256_hmaxabs_epi16(__m256i x)
+{
+    __m256i abs16 = _mm256_abs_epi16(x);
+    __m128i lo128 = _mm256_castsi256_si128(abs16);
+    __m128i hi128 = _mm256_extracti128_si256(abs16, 1);
+    __m128i max16 = _mm_max_epu16(lo128, hi128);
+    __m128i min16 = _mm_minpos_epu16(_mm_xor_si128(max16, _mm_set1_epi16(-1)));
+    return (0xFFFF ^ _mm_extract_epi16(min16, 0));
+}
+
+
 // 0 <= x < 4  -->  (1 << (x - 1))  -->  0, 1, 2, 4
 AYMO_INLINE
 __m256i mm256_pow2m1lt4_epi16(__m256i x)
@@ -383,6 +482,63 @@ __m256i mm256_pow2lt4_epi16(__m256i x)
 }
 
 
+// 0 <= x < 4  -->  (1 << (x * 4))  -->  1, 16, 256, 4096
+AYMO_INLINE
+__m256i mm256_pow16lt4_epi16(__m256i x)
+{
+    const __m256i t = _mm256_setr_epi8(
+        1, 16, 0, 0, 0, 0, 1, 16, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 16, 0, 0, 0, 0, 1, 16, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m256i i = vadd(vmululo(x, vset1(0x0101)), vset1(0x0400));
+    return _mm256_shuffle_epi8(t, i);
+}
+
+
+// 0 <= x < 0x10, 0 <= n < 16  -->  (x >> n)
+AYMO_INLINE
+__m256i mm256_srlvx4lt16_epi16(__m256i x, __m256i n)
+{
+    const __m256i t = _mm256_setr_epi8(
+        16, 8, 4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        16, 8, 4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m256i p = _mm256_shuffle_epi8(t, n);
+    return vsrli(_mm256_maddubs_epi16(p, x), 4);
+}
+
+
+// 0 <= x < 0x1000, 0 <= n < 16  -->  (x >> n)
+AYMO_INLINE
+__m256i mm256_srlvx12lt16_epi16(__m256i x, __m256i n)
+{
+    const __m256i tlo = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, -128, 64, 32, 16, 8, 4, 2, 1, 0, 0, 0,
+        0, 0, 0, 0, 0, -128, 64, 32, 16, 8, 4, 2, 1, 0, 0, 0
+    );
+    const __m256i thi = _mm256_setr_epi8(
+        16, 8, 4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        16, 8, 4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m256i plo = _mm256_shuffle_epi8(tlo, n);
+    __m256i phi = vslli(_mm256_shuffle_epi8(thi, n), 8);
+    return vmuluhi(vslli(x, 4), vor(plo, phi));
+}
+
+
+// 0 <= n < 4  -->  (x >> (4 - n))
+AYMO_INLINE
+__m256i mm256_srl4subvlt4_epi16(__m256i x, __m256i n)
+{
+    const __m256i t = _mm256_setr_epi8(
+        16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m256i p = vslli(_mm256_shuffle_epi8(t, n), 8);
+    return vmuluhi(x, p);
+}
+
+
 AYMO_INLINE
 long mm256_extractn_epi32(__m256i x, const int i)
 {
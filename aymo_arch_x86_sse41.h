@@ -38,6 +38,8 @@ typedef __m128i aymou16_t;
 typedef __m128i aymoi32_t;
 typedef __m128i aymou32_t;
 
+typedef __m128 aymof32_t;
+
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -75,6 +75,8 @@ extern "C" {
 #define vsllv            mm_sllv_epi16
 #define vsrlv            mm_srlv_epi16
 #define vsrav            mm_srav_epi16
+#define vbslli          _mm_bslli_si128  // bytes
+#define vbsrli          _mm_bsrli_si128  // bytes
                         
 #define vmulihi         _mm_mulhi_epi16
 #define vmuluhi         _mm_mulhi_epu16
@@ -95,12 +97,21 @@ extern "C" {
 #define vinsertn         mm_insertn_epi16
                         
 #define vgather          mm_i16gather_epi16lo
+#define vstoreu(p,x)    (_mm_storeu_si128((__m128i*)(void*)(p), (x)))
                         
 #define vhsum            mm_hsum_epi16
 #define vhsums           mm_hsums_epi16
+#define vhsumsq          mm_hsumsq_epi16
+#define vhmaxabs         mm_hmaxabs_epi16
+
+#define vtestf(x)       (_mm_test_all_ones(x))
                         
 #define vpow2m1lt4       mm_pow2m1lt4_epi16
 #define vpow2lt4         mm_pow2lt4_epi16
+#define vpow16lt4        mm_pow16lt4_epi16
+#define vsrlvx4lt16      mm_srlvx4lt16_epi16
+#define vsrlvx12lt16     mm_srlvx12lt16_epi16
+#define vsrl4subvlt4     mm_srl4subvlt4_epi16
                         
 #define vunpacklo       _mm_unpacklo_epi16
 #define vunpackhi       _mm_unpackhi_epi16
@@ -122,8 +133,12 @@ extern "C" {
 #define vvandnot        vandnot
                         
 #define vvadd           _mm_add_epi32
+#define vvsub           _mm_sub_epi32
+
+#define vvcmpgt         _mm_cmpgt_epi32
                         
 #define vvsrli          _mm_srli_epi32
+#define vvsrai          _mm_srai_epi32
                         
 #define vvsllv          _mm_sllv_epi32
                         
@@ -136,6 +151,26 @@ extern "C" {
 #define vvmullo         _mm_mullo_epi32
                         
 #define vvpackus        _mm_packus_epi32
+#define vvpacks         _mm_packs_epi32
+
+#define vvunpacklo      _mm_cvtepi16_epi32
+#define vvunpackhi(x)   (_mm_cvtepi16_epi32(_mm_unpackhi_epi64((x), (x))))
+#define vvslli          _mm_slli_epi32
+#define vvmadd          _mm_madd_epi16
+#define vvhsum           mm_hsum_epi32
+
+
+#define vfset1          _mm_set1_ps
+#define vfmul           _mm_mul_ps
+#define vfcvt           _mm_cvtepi32_ps
+#define vfcvtt          _mm_cvttps_epi32
+
+
+#define vloadu(p)       (_mm_loadu_si128((const __m128i*)(const void*)(p)))
+#define vvstoreu(p,x)   (_mm_storeu_si128((__m128i*)(void*)(p), (x)))
+#define vfstoreu        _mm_storeu_ps
+#define vstore24         mm_store24_epi16
+#define vmix4to2         mm_mix4to2_epi16
 
 
 AYMO_INLINE
@@ -321,6 +356,52 @@ int mm_hsums_epi16(__m128i x)
 }
 
 
+// Stores as 24-bit little-endian samples, scaled by 256
+AYMO_INLINE
+void mm_store24_epi16(uint8_t* p, __m128i x)
+{
+    __m128i lo = _mm_shuffle_epi8(x, _mm_setr_epi8(
+        -1, 0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1
+    ));
+    __m128i hi = _mm_shuffle_epi8(x, _mm_setr_epi8(
+        10, 11, -1, 12, 13, -1, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1
+    ));
+    _mm_storeu_si128((__m128i*)(void*)p, lo);
+    _mm_storel_epi64((__m128i*)(void*)(p + 16), hi);
+}
+
+
+// Downmixes interleaved a/b/c/d frames into a+c/b+d frames, saturated
+AYMO_INLINE
+__m128i mm_mix4to2_epi16(__m128i x0, __m128i x1)
+{
+    __m128i s0 = _mm_adds_epi16(x0, _mm_srli_epi64(x0, 32));
+    __m128i s1 = _mm_adds_epi16(x1, _mm_srli_epi64(x1, 32));
+    __m128i p0 = _mm_shuffle_epi32(s0, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128i p1 = _mm_shuffle_epi32(s1, _MM_SHUFFLE(2, 0, 2, 0));
+    return _mm_unpacklo_epi64(p0, p1);
+}
+
+
+// Sum of squares, modulo 2^32
+AYMO_INLINE
+uint32_t mm_hsumsq_epi16(__m128i x)
+{
+    __m128i sq32 = _mm_madd_epi16(x, x);
+    return (uint32_t)mm_hsum_epi32(sq32);
+}
+
+
+// Maximum absolute value, as unsigned
+AYMO_INLINE
+int mm_hmaxabs_epi16(__m128i x)
+{
+    __m128i abs16 = _mm_abs_epi16(x);
+    __m128i min16 = _mm_minpos_epu16(vnot(abs16));
+    return (0xFFFF ^ _mm_extract_epi16(min16, 0));
+}
+
+
 // 0 <= x < 4  -->  (1 << (x - 1))  -->  0, 1, 2, 4
 AYMO_INLINE
 __m128i mm_pow2m1lt4_epi16(__m128i x)
@@ -340,6 +421,58 @@ __m128i mm_pow2lt4_epi16(__m128i x)
 }
 
 
+// 0 <= x < 4  -->  (1 << (x * 4))  -->  1, 16, 256, 4096
+AYMO_INLINE
+__m128i mm_pow16lt4_epi16(__m128i x)
+{
+    const __m128i t = _mm_setr_epi8(
+        1, 16, 0, 0, 0, 0, 1, 16, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m128i i = vadd(vmululo(x, vset1(0x0101)), vset1(0x0400));
+    return _mm_shuffle_epi8(t, i);
+}
+
+
+// 0 <= x < 0x10, 0 <= n < 16  -->  (x >> n)
+AYMO_INLINE
+__m128i mm_srlvx4lt16_epi16(__m128i x, __m128i n)
+{
+    const __m128i t = _mm_setr_epi8(
+        16, 8, 4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m128i p = _mm_shuffle_epi8(t, n);
+    return vsrli(_mm_maddubs_epi16(p, x), 4);
+}
+
+
+// 0 <= x < 0x1000, 0 <= n < 16  -->  (x >> n)
+AYMO_INLINE
+__m128i mm_srlvx12lt16_epi16(__m128i x, __m128i n)
+{
+    const __m128i tlo = _mm_setr_epi8(
+        0, 0, 0, 0, 0, -128, 64, 32, 16, 8, 4, 2, 1, 0, 0, 0
+    );
+    const __m128i thi = _mm_setr_epi8(
+        16, 8, 4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m128i plo = _mm_shuffle_epi8(tlo, n);
+    __m128i phi = vslli(_mm_shuffle_epi8(thi, n), 8);
+    return vmuluhi(vslli(x, 4), vor(plo, phi));
+}
+
+
+// 0 <= n < 4  -->  (x >> (4 - n))
+AYMO_INLINE
+__m128i mm_srl4subvlt4_epi16(__m128i x, __m128i n)
+{
+    const __m128i t = _mm_setr_epi8(
+        16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    );
+    __m128i p = vslli(_mm_shuffle_epi8(t, n), 8);
+    return vmuluhi(x, p);
+}
+
+
 AYMO_INLINE
 long mm_extractn_epi32(__m128i x, const int i)
 {
@@ -243,6 +243,20 @@ int aymo_(sgi_to_cgi)(int sgi)
 }
 
 
+// First slot group of a Channel_2xOP group
+AYMO_INLINE
+int aymo_(cgi_to_sgi)(int cgi)
+{
+//    return (cgi * 2);
+    return (cgi << 1);
+}
+
+
+// Slot group processing order of wave generators, chained by modulation
+AYMO_STATIC
+const int8_t aymo_(wg_order)[AYMO_(SLOT_GROUP_NUM)] = { 0, 1, 2, 3 };
+
+
 // Sub-address to Slot index
 AYMO_STATIC AYMO_ALIGN_V16
 const int8_t aymo_(subaddr_to_slot)[AYMO_(SLOT_NUM_MAX)] =
@@ -322,6 +336,59 @@ const uint16_t aymo_(eg_incstep_table)[4] =
 };
 
 
+// Tremolo LFO values by position, for the BDh.dam setting
+AYMO_STATIC
+const uint8_t aymo_(eg_tremolo_table)[2/* dam */][210] =
+{
+    {
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+         0,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+         1,  1,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+         2,  2,  2,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+         3,  3,  3,  3,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+         4,  4,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,
+         5,  5,  5,  5,  5,  5,  6,  6,  6,  6,  6,  6,  6,  6,  6,
+         6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  5,  5,  5,  5,  5,
+         5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  4,  4,  4,  4,
+         4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  3,  3,  3,
+         3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  2,  2,
+         2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  1,
+         1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0
+    },
+    {
+         0,  0,  0,  0,  1,  1,  1,  1,  2,  2,  2,  2,  3,  3,  3,
+         3,  4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,  6,  7,  7,
+         7,  7,  8,  8,  8,  8,  9,  9,  9,  9, 10, 10, 10, 10, 11,
+        11, 11, 11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14,
+        15, 15, 15, 15, 16, 16, 16, 16, 17, 17, 17, 17, 18, 18, 18,
+        18, 19, 19, 19, 19, 20, 20, 20, 20, 21, 21, 21, 21, 22, 22,
+        22, 22, 23, 23, 23, 23, 24, 24, 24, 24, 25, 25, 25, 25, 26,
+        26, 26, 25, 25, 25, 25, 24, 24, 24, 24, 23, 23, 23, 23, 22,
+        22, 22, 22, 21, 21, 21, 21, 20, 20, 20, 20, 19, 19, 19, 19,
+        18, 18, 18, 18, 17, 17, 17, 17, 16, 16, 16, 16, 15, 15, 15,
+        15, 14, 14, 14, 14, 13, 13, 13, 13, 12, 12, 12, 12, 11, 11,
+        11, 11, 10, 10, 10, 10,  9,  9,  9,  9,  8,  8,  8,  8,  7,
+         7,  7,  7,  6,  6,  6,  6,  5,  5,  5,  5,  4,  4,  4,  4,
+         3,  3,  3,  3,  2,  2,  2,  2,  1,  1,  1,  1,  0,  0,  0
+    }
+};
+
+// Vibrato LFO factors by position, for the BDh.dvb setting
+AYMO_STATIC
+const int16_t aymo_(pg_vib_mulhi_table)[2/* dvb */][8] =
+{
+    { 0x0000, 0x0080, 0x0100, 0x0080, 0x0000, 0x0080, 0x0100, 0x0080 },
+    { 0x0000, 0x0100, 0x0200, 0x0100, 0x0000, 0x0100, 0x0200, 0x0100 }
+};
+
+AYMO_STATIC
+const int16_t aymo_(pg_vib_neg_table)[8] =
+{
+    0, 0, 0, 0, -1, -1, -1, -1
+};
+
+
 // Wave descriptors
 AYMO_STATIC AYMO_ALIGN_V16
 const struct aymo_(wave) aymo_(wave_table)[8] =
@@ -430,28 +497,14 @@ const uint16_t aymo_(og_prout_bd)[AYMO_(SLOT_GROUP_NUM)] =
 };
 
 
-// Updates wave generators
+// Computes the wave output of slots from their phase input
 AYMO_INLINE
-void aymo_(wg_update)(
-    struct aymo_(chip)* chip,
-    struct aymo_(ch2x_group)* cg,
-    struct aymo_(slot_group)* sg
-)
+aymoi16_t aymo_(wg_compute)(const struct aymo_(slot_group)* sg, aymoi16_t phase)
 {
-    // Compute feedback and modulation inputs
-    aymoi16_t fbsum = vslli(vadd(sg->wg_out, sg->wg_prout), 1);
-    aymoi16_t fbsum_sh = vmulihi(fbsum, sg->wg_fb_mulhi);
-    aymoi16_t prmod = vand(chip->wg_mod, sg->wg_prmod_gate);
-    aymoi16_t fbmod = vand(fbsum_sh, sg->wg_fbmod_gate);
-    sg->wg_prout = sg->wg_out;
-
-    // Compute operator phase input
-    aymoi16_t modsum = vadd(fbmod, prmod);
-    aymoi16_t phase = vadd(sg->pg_phase_out, modsum);
-
     // Process phase
     aymoi16_t phase_sped = vu2i(vmululo(vi2u(phase), sg->wg_phase_mullo));
     aymoi16_t phase_gate = vcmpz(vand(phase_sped, sg->wg_phase_zero));
+
     aymoi16_t phase_flip = vcmpp(vand(phase_sped, sg->wg_phase_flip));
     aymoi16_t phase_mask = sg->wg_phase_mask;
     aymoi16_t phase_xor = vand(phase_flip, phase_mask);
@@ -466,16 +519,39 @@ void aymo_(wg_update)(
     // Compute exponential output
     aymoi16_t exp_in = vblendv(phase_out, logsin_val, sg->wg_sine_gate);
     aymoi16_t exp_level = vadd(exp_in, vslli(sg->eg_out, 3));
-    exp_level = vmini(exp_level, vset1(0x1FFF));
+    exp_level = vmini(exp_level, vset1(0x0FFF));  // any level >= 0x0C00 yields 0 anyway
     aymoi16_t exp_level_lo = exp_level;  // vgather() masks to low byte
     aymoi16_t exp_level_hi = vsrli(exp_level, 8);
     aymoi16_t exp_value = vgather(aymo_(exp_x2_table), exp_level_lo);
-    aymoi16_t exp_out = vsrlv(exp_value, exp_level_hi);
+    aymoi16_t exp_out = vsrlvx12lt16(exp_value, exp_level_hi);
 
     // Compute operator wave output
     aymoi16_t wave_pos = vcmpz(vand(phase_sped, sg->wg_phase_neg));
     aymoi16_t wave_neg = vandnot(wave_pos, phase_gate);
-    aymoi16_t wave_out = vxor(exp_out, wave_neg);
+    return vxor(exp_out, wave_neg);
+}
+
+
+// Computes the wave output of silent slots from their phase input, as only the sign
+AYMO_INLINE
+aymoi16_t aymo_(wg_compute_silent)(const struct aymo_(slot_group)* sg, aymoi16_t phase)
+{
+    aymoi16_t phase_sped = vu2i(vmululo(vi2u(phase), sg->wg_phase_mullo));
+    aymoi16_t phase_gate = vcmpz(vand(phase_sped, sg->wg_phase_zero));
+    aymoi16_t wave_pos = vcmpz(vand(phase_sped, sg->wg_phase_neg));
+    return vandnot(wave_pos, phase_gate);
+}
+
+
+// Updates wave generator and chip outputs from the wave output of slots
+AYMO_INLINE
+void aymo_(wg_update_out)(
+    struct aymo_(chip)* chip,
+    struct aymo_(slot_group)* sg,
+    aymoi16_t wave_out
+)
+{
+    sg->wg_prout = sg->wg_out;
     sg->wg_out = wave_out;
     chip->wg_mod = wave_out;
 
@@ -483,10 +559,46 @@ void aymo_(wg_update)(
     aymoi16_t og_out_ac = vblendv(wave_out, sg->og_prout, sg->og_prout_ac);
     aymoi16_t og_out_bd = vblendv(wave_out, sg->og_prout, sg->og_prout_bd);
     sg->og_prout = wave_out;
+
+    // Rhythm doubles the delayed slot outputs
+    og_out_ac = vadd(og_out_ac, vand(og_out_ac, sg->og_ryt_gate));
+    og_out_bd = vadd(og_out_bd, vand(og_out_bd, sg->og_ryt_gate));
+
     chip->og_acc_a = vadd(chip->og_acc_a, vand(og_out_ac, sg->og_out_ch_gate_a));
     chip->og_acc_c = vadd(chip->og_acc_c, vand(og_out_ac, sg->og_out_ch_gate_c));
     chip->og_acc_b = vadd(chip->og_acc_b, vand(og_out_bd, sg->og_out_ch_gate_b));
     chip->og_acc_d = vadd(chip->og_acc_d, vand(og_out_bd, sg->og_out_ch_gate_d));
+}
+
+
+// Updates wave generators
+// Silent slot groups output only their sign, skipping the table lookups
+AYMO_INLINE
+void aymo_(wg_update)(
+    struct aymo_(chip)* chip,
+    struct aymo_(ch2x_group)* cg,
+    struct aymo_(slot_group)* sg,
+    int silent
+)
+{
+    // Compute feedback and modulation inputs
+    aymoi16_t fbsum = vslli(vadd(sg->wg_out, sg->wg_prout), 1);
+    aymoi16_t fbsum_sh = vmulihi(fbsum, sg->wg_fb_mulhi);
+    aymoi16_t prmod = vand(chip->wg_mod, sg->wg_prmod_gate);
+    aymoi16_t fbmod = vand(fbsum_sh, sg->wg_fbmod_gate);
+
+    // Compute operator phase input
+    aymoi16_t modsum = vadd(fbmod, prmod);
+    aymoi16_t phase = vadd(sg->pg_phase_out, modsum);
+
+    aymoi16_t wave_out;
+    if (silent) {
+        wave_out = aymo_(wg_compute_silent)(sg, phase);
+    }
+    else {
+        wave_out = aymo_(wg_compute)(sg, phase);
+    }
+    aymo_(wg_update_out)(chip, sg, wave_out);
 
 #ifdef AYMO_DEBUG
     sg->wg_fbmod = fbsum_sh;
@@ -527,7 +639,7 @@ void aymo_(eg_update)(
     // Compute shift
     aymoi16_t eg_shift = vadd(rate_hi, chip->eg_add);
     aymoi16_t rate_pre_lt12 = vor(vslli(rate_lo, 1), vset1(8));
-    aymoi16_t shift_lt12 = vsrlv(rate_pre_lt12, vsubsu(vset1(15), eg_shift));
+    aymoi16_t shift_lt12 = vsrlvx4lt16(rate_pre_lt12, vsubsu(vset1(15), eg_shift));
     shift_lt12 = vand(shift_lt12, chip->eg_statev);
 
     aymou16_t rate_lo_muluhi = vi2u(vslli(vpow2m1lt4(rate_lo), 1));
@@ -556,7 +668,7 @@ void aymo_(eg_update)(
     // Move attack to decay state
     aymoi16_t eg_inc_atk_cond = vand(vand(vcmpp(sg->eg_key), vcmpp(shift)),
                                      vand(vcmpz(sg->eg_gen), vcmpgt(vset1(15), rate_hi)));
-    aymoi16_t eg_inc_atk_ninc = vsrlv(sg->eg_rout, vsub(vset1(4), shift));
+    aymoi16_t eg_inc_atk_ninc = vsrl4subvlt4(sg->eg_rout, shift);
     aymoi16_t eg_inc = vandnot(eg_inc_atk_ninc, eg_inc_atk_cond);
     aymoi16_t eg_gen_atk_to_dec = vcmpz(vor(sg->eg_gen, sg->eg_rout));
     eg_gen = vsub(eg_gen, eg_gen_atk_to_dec);  // 0 --> 1
@@ -581,7 +693,7 @@ void aymo_(eg_update)(
     eg_rout = vand(eg_rout, vset1(0x01FF));
     sg->eg_rout = eg_rout;
     sg->eg_gen = eg_gen;
-    sg->eg_gen_mullo = vsllv(vset1(1), vslli(eg_gen, 2));
+    sg->eg_gen_mullo = vpow16lt4(eg_gen);
 
 #ifdef AYMO_DEBUG
     sg->eg_rate = rate;
@@ -590,6 +702,82 @@ void aymo_(eg_update)(
 }
 
 
+// Tells which slots cannot change envelope state, whatever the envelope timing
+AYMO_INLINE
+aymoi16_t aymo_(eg_steady)(const struct aymo_(slot_group)* sg)
+{
+    aymoi16_t eg_gen_rel = vcmpeq(sg->eg_gen, vset1(AYMO_(EG_GEN_RELEASE)));
+    aymoi16_t notreset = vcmpz(vand(sg->eg_key, eg_gen_rel));
+    aymoi16_t reg_rate = vu2i(vmululo(vi2u(sg->eg_adsr), vi2u(sg->eg_gen_mullo)));
+    aymoi16_t rate_zero = vcmpz(vand(reg_rate, vset1((int16_t)0xF000)));
+
+    // Attack: no increment, and not moving to decay
+    aymoi16_t steady_atk = vandnot(vcmpz(sg->eg_rout), rate_zero);
+
+    // Not attack: either off, or no increment and not turning off
+    aymoi16_t eg_off = vcmpeq(sg->eg_rout, vset1(0x01FF));
+    aymoi16_t eg_on = vcmpgt(vset1(0x01F8), sg->eg_rout);
+    aymoi16_t steady_natk = vor(eg_off, vand(rate_zero, eg_on));
+
+    aymoi16_t steady = vblendv(steady_natk, steady_atk, vcmpz(sg->eg_gen));
+
+    // No decay to sustain, no key-off to release, no phase reset
+    aymoi16_t eg_gen_dec = vcmpeq(sg->eg_gen, vset1(AYMO_(EG_GEN_DECAY)));
+    aymoi16_t sl_hit = vcmpeq(vsrli(sg->eg_rout, 4), sg->eg_sl);
+    steady = vandnot(vand(eg_gen_dec, sl_hit), steady);
+    steady = vand(steady, vor(vcmpp(sg->eg_key), eg_gen_rel));
+    steady = vand(steady, notreset);
+    steady = vand(steady, vcmpeq(sg->eg_gen_mullo, vpow16lt4(sg->eg_gen)));  // rate in sync
+    return steady;
+}
+
+
+// Wakes up the envelope generators of a slot group, after a register change
+AYMO_INLINE
+void aymo_(eg_wake)(struct aymo_(chip)* chip, int sgi)
+{
+    chip->eg_idle &= ~(1u << (unsigned)sgi);
+    chip->wg_silent &= ~(1u << (unsigned)sgi);
+}
+
+
+// Updates envelope generators, skipping slot groups with steady envelopes
+// A steady group keeps its state until woken up by a register change
+AYMO_INLINE
+void aymo_(eg_update_lazy)(
+    struct aymo_(chip)* chip,
+    struct aymo_(ch2x_group)* cg,
+    struct aymo_(slot_group)* sg
+)
+{
+    uint32_t sgm = (1u << (unsigned)(sg - chip->sg));
+
+    if (chip->eg_idle & sgm) {
+        sg->eg_out = vadd(
+            vadd(sg->eg_rout, sg->eg_tl_x4),
+            vadd(sg->eg_ksl_sh, sg->eg_tremolo_am)
+        );
+        sg->pg_notreset = vsetf();
+#ifdef AYMO_DEBUG
+        sg->eg_inc = vsetz();
+#endif
+    }
+    else {
+        aymo_(eg_update)(chip, cg, sg);
+
+        if (vtestf(aymo_(eg_steady)(sg))) {
+            chip->eg_idle |= sgm;
+
+            // Any level >= 0x0C00 yields 0, whatever the tremolo
+            aymoi16_t eg_level = vadd(vadd(sg->eg_rout, sg->eg_tl_x4), sg->eg_ksl_sh);
+            if (vtestf(vcmpgt(eg_level, vset1(0x017F)))) {
+                chip->wg_silent |= sgm;
+            }
+        }
+    }
+}
+
+
 // Updates phase generator
 AYMO_INLINE
 void aymo_(pg_update_deltafreq)(
@@ -598,10 +786,12 @@ void aymo_(pg_update_deltafreq)(
     struct aymo_(slot_group)* sg
 )
 {
+    const struct aymo_(slot_group_cold)* sgc = &chip->sg_cold[sg - chip->sg];
+
     // Update phase
     aymoi16_t fnum = cg->pg_fnum;
     aymoi16_t range = vand(fnum, vset1(7 << 7));
-    range = vmulihi(range, vand(sg->pg_vib, chip->pg_vib_mulhi));
+    range = vmulihi(range, vand(sgc->pg_vib, chip->pg_vib_mulhi));
     range = vsub(vxor(range, chip->pg_vib_neg), chip->pg_vib_neg);  // flip sign
     fnum = vadd(fnum, range);
 
@@ -611,14 +801,41 @@ void aymo_(pg_update_deltafreq)(
     aymoi32_t block_sll_hi = vunpackhi(cg->pg_block, vsetz());
     aymoi32_t basefreq_lo = vvsrli(vvsllv(fnum_lo, block_sll_lo), 1);
     aymoi32_t basefreq_hi = vvsrli(vvsllv(fnum_hi, block_sll_hi), 1);
-    aymoi32_t pg_mult_x2_lo = vunpacklo(sg->pg_mult_x2, vsetz());
-    aymoi32_t pg_mult_x2_hi = vunpackhi(sg->pg_mult_x2, vsetz());
+    aymoi32_t pg_mult_x2_lo = vunpacklo(sgc->pg_mult_x2, vsetz());
+    aymoi32_t pg_mult_x2_hi = vunpackhi(sgc->pg_mult_x2, vsetz());
     aymoi32_t deltafreq_lo = vvsrli(vvmullo(basefreq_lo, pg_mult_x2_lo), 1);
     aymoi32_t deltafreq_hi = vvsrli(vvmullo(basefreq_hi, pg_mult_x2_hi), 1);
-    sg->pg_deltafreq_lo = deltafreq_lo;
-    sg->pg_deltafreq_hi = deltafreq_hi;
+
+    // Split at the phase output bit position
+    aymoi32_t frac_mask = vvset1(0x01FF);
+    sg->pg_deltafreq = vvpackus(vvsrli(deltafreq_lo, 9), vvsrli(deltafreq_hi, 9));
+    sg->pg_deltafreq_frac = vvpackus(vvand(deltafreq_lo, frac_mask), vvand(deltafreq_hi, frac_mask));
+    chip->pg_deltafreq_serial++;
 }
 
+
+// Recomputes the phase increments of slot groups marked as dirty
+// Coalesces register writes and vibrato steps up to the next tick
+AYMO_INLINE
+void aymo_(pg_flush_deltafreq)(struct aymo_(chip)* chip)
+{
+    uint32_t dirty = chip->pg_deltafreq_dirty;
+
+    if (dirty) {
+        chip->pg_deltafreq_dirty = 0;
+
+        for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
+            if (dirty & (1u << (unsigned)sgi)) {
+                int cgi = aymo_(sgi_to_cgi)(sgi);
+                struct aymo_(ch2x_group)* cg = &chip->cg[cgi];
+                struct aymo_(slot_group)* sg = &chip->sg[sgi];
+                aymo_(pg_update_deltafreq)(chip, cg, sg);
+            }
+        }
+    }
+}
+
+
 // Updates phase generator
 AYMO_INLINE
 void aymo_(pg_update)(
@@ -630,19 +847,97 @@ void aymo_(pg_update)(
     (void)cg;
 
     // Compute phase output
-    aymoi32_t phase_out_mask = vvset1(0xFFFF);
-    aymoi32_t phase_out_lo = vvand(vvsrli(sg->pg_phase_lo, 9), phase_out_mask);
-    aymoi32_t phase_out_hi = vvand(vvsrli(sg->pg_phase_hi, 9), phase_out_mask);
-    aymoi16_t phase_out = vvpackus(phase_out_lo, phase_out_hi);
-    sg->pg_phase_out = phase_out;
+    sg->pg_phase_out = sg->pg_phase;
+
+    // Update phase, carrying the fractional part into the integer part
+    aymoi16_t notreset = sg->pg_notreset;
+    aymoi16_t phase_frac = vadd(vand(notreset, sg->pg_phase_frac), sg->pg_deltafreq_frac);
+    aymoi16_t phase = vadd(vand(notreset, sg->pg_phase), sg->pg_deltafreq);
+    sg->pg_phase = vadd(phase, vsrli(phase_frac, 9));
+    sg->pg_phase_frac = vand(phase_frac, vset1(0x01FF));
+}
 
-    // Update phase
-    aymoi32_t notreset_lo = vunpacklo(sg->pg_notreset, sg->pg_notreset);
-    aymoi32_t notreset_hi = vunpackhi(sg->pg_notreset, sg->pg_notreset);
-    aymoi32_t pg_phase_lo = vvand(notreset_lo, sg->pg_phase_lo);
-    aymoi32_t pg_phase_hi = vvand(notreset_hi, sg->pg_phase_hi);
-    sg->pg_phase_lo = vvadd(pg_phase_lo, sg->pg_deltafreq_lo);
-    sg->pg_phase_hi = vvadd(pg_phase_hi, sg->pg_deltafreq_hi);
+
+// Advances the phase of a run by the ticks consumed so far
+AYMO_INLINE
+void aymo_(pg_run_sync)(struct aymo_(slot_group)* sg, struct aymo_(pg_run)* run, int sgi)
+{
+    if (run->pos[sgi]) {
+        aymoi16_t pos = vset1((int16_t)run->pos[sgi]);
+        aymoi16_t phase_frac = vadd(sg->pg_phase_frac, vu2i(vmululo(vi2u(pos), vi2u(run->pg_deltafreq_frac[sgi]))));
+        aymoi16_t phase = vadd(sg->pg_phase, vu2i(vmululo(vi2u(pos), vi2u(run->pg_deltafreq[sgi]))));
+        sg->pg_phase = vadd(phase, vsrli(phase_frac, 9));
+        sg->pg_phase_frac = vand(phase_frac, vset1(0x01FF));
+    }
+    run->pos[sgi] = 0;
+    run->len[sgi] = 0;
+}
+
+
+// Precomputes the phase outputs of a run of ticks
+AYMO_INLINE
+void aymo_(pg_run_fill)(struct aymo_(chip)* chip, struct aymo_(slot_group)* sg, struct aymo_(pg_run)* run, int sgi)
+{
+    aymoi16_t frac_mask = vset1(0x01FF);
+    aymoi16_t phase = sg->pg_phase;
+    aymoi16_t phase_frac = sg->pg_phase_frac;
+    aymoi16_t deltafreq = sg->pg_deltafreq;
+    aymoi16_t deltafreq_frac = sg->pg_deltafreq_frac;
+
+    for (int k = 0; k < AYMO_(PG_RUN_LENGTH); ++k) {
+        run->pg_phase_out[sgi][k] = phase;
+        phase_frac = vadd(phase_frac, deltafreq_frac);
+        phase = vadd(vadd(phase, deltafreq), vsrli(phase_frac, 9));
+        phase_frac = vand(phase_frac, frac_mask);
+    }
+    run->pg_deltafreq[sgi] = deltafreq;
+    run->pg_deltafreq_frac[sgi] = deltafreq_frac;
+    run->pg_deltafreq_serial[sgi] = chip->pg_deltafreq_serial;
+    run->pos[sgi] = 0;
+    run->len[sgi] = AYMO_(PG_RUN_LENGTH);
+}
+
+
+// Updates phase generator from a precomputed run, if any
+// Phase resets and frequency changes break the run
+AYMO_INLINE
+void aymo_(pg_update_run)(
+    struct aymo_(chip)* chip,
+    struct aymo_(ch2x_group)* cg,
+    struct aymo_(slot_group)* sg,
+    struct aymo_(pg_run)* run
+)
+{
+    if (!run) {
+        aymo_(pg_update)(chip, cg, sg);
+        return;
+    }
+    int sgi = (int)(sg - chip->sg);
+
+    if ((run->pos[sgi] >= run->len[sgi]) ||
+        (run->pg_deltafreq_serial[sgi] != chip->pg_deltafreq_serial)) {
+        aymo_(pg_run_sync)(sg, run, sgi);
+        aymo_(pg_run_fill)(chip, sg, run, sgi);
+    }
+
+    if (vtestf(sg->pg_notreset)) {
+        sg->pg_phase_out = run->pg_phase_out[sgi][run->pos[sgi]++];
+    }
+    else {
+        aymo_(pg_run_sync)(sg, run, sgi);
+        aymo_(pg_update)(chip, cg, sg);
+    }
+}
+
+
+// Advances the 23-bit noise LFSR by up to 9 steps at once
+// The feedback taps are 14 bits apart, so the first 9 new bits depend only on
+// the current state, and can be computed all together in closed form
+AYMO_INLINE
+uint32_t aymo_(ng_leap)(uint32_t noise, unsigned times)
+{
+    uint32_t n_bits = (((noise >> 14) ^ noise) & ((1U << times) - 1U));
+    return ((noise >> times) | (n_bits << (23 - times)));
 }
 
 
@@ -650,16 +945,72 @@ void aymo_(pg_update)(
 AYMO_INLINE
 void aymo_(ng_update)(struct aymo_(chip)* chip, unsigned times)
 {
-    // Update noise
+    // Update noise, by leaps of 9 steps
     uint32_t noise = chip->ng_noise;
-    while (times--) {
-        uint32_t n_bit = (((noise >> 14) ^ noise) & 1);
-        noise = ((noise >> 1) | (n_bit << 22));
+    while (times > 9) {
+        noise = aymo_(ng_leap)(noise, 9);
+        times -= 9;
+    }
+    chip->ng_noise = aymo_(ng_leap)(noise, times);
+}
+
+
+// Applies a noise LFSR jump matrix over GF(2), stored by columns
+AYMO_STATIC
+uint32_t aymo_(ng_jump_apply)(const uint32_t matrix[23], uint32_t noise)
+{
+    uint32_t result = 0;
+    for (int i = 0; i < 23; ++i) {
+        result ^= (matrix[i] & (0U - ((noise >> i) & 1U)));
+    }
+    return result;
+}
+
+
+// Advances the noise generator by many steps, in O(log(steps)) time
+void aymo_(ng_skip)(struct aymo_(chip)* chip, uint64_t steps)
+{
+    // Single step jump matrix
+    uint32_t jump[23];
+    for (int i = 0; i < 23; ++i) {
+        jump[i] = aymo_(ng_leap)((1U << i), 1);
+    }
+
+    uint32_t noise = chip->ng_noise;
+    while (steps) {
+        if (steps & 1) {
+            noise = aymo_(ng_jump_apply)(jump, noise);
+        }
+        steps >>= 1;
+
+        if (steps) {
+            // Square the jump matrix
+            uint32_t square[23];
+            for (int i = 0; i < 23; ++i) {
+                square[i] = aymo_(ng_jump_apply)(jump, jump[i]);
+            }
+            for (int i = 0; i < 23; ++i) {
+                jump[i] = square[i];
+            }
+        }
     }
     chip->ng_noise = noise;
 }
 
 
+// Computes the rhythm noise bit, from HH and TC phases at the same lane
+AYMO_INLINE
+aymoi16_t aymo_(rm_xor)(aymoi16_t hh, aymoi16_t tc)
+{
+    aymoi16_t tc_bit5 = vsrli(tc, 5);
+    aymoi16_t hh_bit2_xor_bit7 = vxor(vsrli(hh, 2), vsrli(hh, 7));
+    aymoi16_t hh_bit3_xor_tc_bit5 = vxor(vsrli(hh, 3), tc_bit5);
+    aymoi16_t tc_bit3_xor_bit5 = vxor(vsrli(tc, 3), tc_bit5);
+    aymoi16_t rm_xor = vor(vor(hh_bit2_xor_bit7, hh_bit3_xor_tc_bit5), tc_bit3_xor_bit5);
+    return vand(rm_xor, vset1(1));
+}
+
+
 // Updates rhythm manager, slot group 0
 AYMO_INLINE
 void aymo_(rm_update_sg0)(struct aymo_(chip)* chip)
@@ -667,43 +1018,16 @@ void aymo_(rm_update_sg0)(struct aymo_(chip)* chip)
     struct aymo_(slot_group)* sg = &chip->sg[0];
 
     if (chip->chip_regs.reg_BDh.ryt) {
-        // Double rhythm outputs
-        aymoi16_t ryt_slot_mask = vsetr(0, 0, 0, 0, 0, 0, 0, 0, -1, -1, -1, 0, 0, 0, 0, 0);
-        aymoi16_t wave_out = vand(sg->wg_out, ryt_slot_mask);
-        chip->og_acc_a = vadd(chip->og_acc_a, vand(wave_out, sg->og_out_ch_gate_a));
-        chip->og_acc_b = vadd(chip->og_acc_b, vand(wave_out, sg->og_out_ch_gate_b));
-        chip->og_acc_c = vadd(chip->og_acc_c, vand(wave_out, sg->og_out_ch_gate_c));
-        chip->og_acc_d = vadd(chip->og_acc_d, vand(wave_out, sg->og_out_ch_gate_d));
-    }
-
-    aymoi16_t phase = sg->pg_phase_out;
-    uint16_t phase13 = (uint16_t)vextract(phase, 9);
-
-    // Update noise bits
-    chip->rm_hh_bit2 = ((phase13 >> 2) & 1);
-    chip->rm_hh_bit3 = ((phase13 >> 3) & 1);
-    chip->rm_hh_bit7 = ((phase13 >> 7) & 1);
-    chip->rm_hh_bit8 = ((phase13 >> 8) & 1);
-
-    if (chip->chip_regs.reg_BDh.ryt) {
-        // Calculate noise bit
-        uint16_t rm_xor = (
-            (chip->rm_hh_bit2 ^ chip->rm_hh_bit7) |
-            (chip->rm_hh_bit3 ^ chip->rm_tc_bit5) |
-            (chip->rm_tc_bit3 ^ chip->rm_tc_bit5)
-        );
+        aymoi16_t phase = sg->pg_phase_out;
+        chip->rm_hh_phase = phase;
 
         // Update HH
-        uint16_t noise = (uint16_t)chip->ng_noise;
-        phase13 = (rm_xor << 9);
-        if (rm_xor ^ (noise & 1)) {
-            phase13 |= 0xD0;
-        } else {
-            phase13 |= 0x34;
-        }
-        phase = vinsert(phase, (int16_t)phase13, 9);
-
-        sg->pg_phase_out = phase;
+        aymoi16_t rm_xor = aymo_(rm_xor)(phase, chip->rm_tc_phase);
+        aymoi16_t noise = vset1((int16_t)(chip->ng_noise & 1));
+        aymoi16_t phase13_hi = vslli(rm_xor, 9);
+        aymoi16_t phase13_lo = vand(vneg(vxor(rm_xor, noise)), vset1(0xD0 ^ 0x34));
+        aymoi16_t phase13 = vor(phase13_hi, vxor(phase13_lo, vset1(0x34)));
+        sg->pg_phase_out = vblendv(phase, phase13, chip->rm_hh_sd_gate);
     }
 }
 
@@ -715,221 +1039,1225 @@ void aymo_(rm_update_sg1)(struct aymo_(chip)* chip)
     struct aymo_(slot_group)* sg = &chip->sg[1];
 
     if (chip->chip_regs.reg_BDh.ryt) {
-        // Double rhythm outputs
-        aymoi16_t ryt_slot_mask = vsetr(0, 0, 0, 0, 0, 0, 0, 0, -1, -1, -1, 0, 0, 0, 0, 0);
-        aymoi16_t wave_out = vand(sg->wg_out, ryt_slot_mask);
-        chip->og_acc_a = vadd(chip->og_acc_a, vand(wave_out, sg->og_out_ch_gate_a));
-        chip->og_acc_b = vadd(chip->og_acc_b, vand(wave_out, sg->og_out_ch_gate_b));
-        chip->og_acc_c = vadd(chip->og_acc_c, vand(wave_out, sg->og_out_ch_gate_c));
-        chip->og_acc_d = vadd(chip->og_acc_d, vand(wave_out, sg->og_out_ch_gate_d));
-
-        // Calculate noise bit
-        uint16_t rm_xor = (
-            (chip->rm_hh_bit2 ^ chip->rm_hh_bit7) |
-            (chip->rm_hh_bit3 ^ chip->rm_tc_bit5) |
-            (chip->rm_tc_bit3 ^ chip->rm_tc_bit5)
-        );
         aymoi16_t phase = sg->pg_phase_out;
+        aymoi16_t hh_phase = chip->rm_hh_phase;
 
         // Update SD
-        uint16_t noise = (uint16_t)chip->ng_noise;
-        uint16_t phase16 = (
-            ((uint16_t)chip->rm_hh_bit8 << 9) |
-            ((uint16_t)(chip->rm_hh_bit8 ^ (noise & 1)) << 8)
-        );
-        phase = vinsert(phase, (int16_t)phase16, 9);
+        aymoi16_t noise = vset1((int16_t)(chip->ng_noise & 1));
+        aymoi16_t hh_bit8 = vand(vsrli(hh_phase, 8), vset1(1));
+        aymoi16_t phase16 = vor(vslli(hh_bit8, 9), vslli(vxor(hh_bit8, noise), 8));
+
+        // Update TC, with HH moved from the SD lane to the TC lane
+        chip->rm_tc_phase = vbsrli(phase, 2);  // TC lane --> HH lane
+        aymoi16_t rm_xor = aymo_(rm_xor)(vbslli(hh_phase, 2), phase);
+        aymoi16_t phase17 = vor(vslli(rm_xor, 9), vset1(0x80));
+
+        phase = vblendv(phase, phase16, chip->rm_hh_sd_gate);
+        phase = vblendv(phase, phase17, chip->rm_tc_gate);
+        sg->pg_phase_out = phase;
+    }
+}
+
+
+// Updates the envelope and phase generators of a slot group
+// Independent of the other slot groups
+AYMO_STATIC
+void aymo_(sg_update_egpg)(
+    struct aymo_(chip)* chip,
+    struct aymo_(ch2x_group)* cg,
+    struct aymo_(slot_group)* sg,
+    struct aymo_(pg_run)* run
+)
+{
+    aymo_(eg_update_lazy)(chip, cg, sg);
+    aymo_(pg_update_run)(chip, cg, sg, run);
+}
+
+
+// Updates the wave generator of a slot group
+// Chained to the previous slot group through the modulation input
+AYMO_STATIC
+void aymo_(sg_update_wg)(
+    struct aymo_(chip)* chip,
+    struct aymo_(ch2x_group)* cg,
+    struct aymo_(slot_group)* sg
+)
+{
+    uint32_t sgm = (1u << (unsigned)(sg - chip->sg));
+
+    // A single test on the common path, for either mask
+    if ((chip->wg_skip | chip->wg_silent) & sgm) {
+        if (chip->wg_skip & sgm) {
+            return;  // muted, and not modulating anything audible
+        }
+        aymo_(wg_update)(chip, cg, sg, 1);
+    }
+    else {
+        aymo_(wg_update)(chip, cg, sg, 0);
+    }
+}
+
+
+// Clear output accumulators
+AYMO_INLINE
+void aymo_(og_clear)(struct aymo_(chip)* chip)
+{
+    chip->og_acc_a = vsetz();
+    chip->og_acc_b = vsetz();
+    chip->og_acc_c = vsetz();
+    chip->og_acc_d = vsetz();
+}
+
+
+// Updates output mixdown
+AYMO_INLINE
+void aymo_(og_update)(struct aymo_(chip)* chip)
+{
+    chip->og_sum_a = vhsum(chip->og_acc_a);
+    chip->og_sum_b = vhsum(chip->og_acc_b);
+    chip->og_sum_c = vhsum(chip->og_acc_c);
+    chip->og_sum_d = vhsum(chip->og_acc_d);
+
+    chip->og_out_a = clamp16(chip->og_sum_a);
+    chip->og_out_b = chip->og_del_b;
+    chip->og_del_b = clamp16(chip->og_sum_b);
+    chip->og_out_c = clamp16(chip->og_sum_c);
+    chip->og_out_d = chip->og_del_d;
+    chip->og_del_d = clamp16(chip->og_sum_d);
+}
+
+
+// Updates tremolo amount of all slots
+AYMO_INLINE
+void aymo_(eg_update_tremolo)(struct aymo_(chip)* chip)
+{
+    int dam = chip->chip_regs.reg_BDh.dam;
+    chip->eg_tremolo = vset1((int16_t)aymo_(eg_tremolo_table)[dam][chip->eg_tremolopos]);
+
+    for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
+        struct aymo_(slot_group)* sg = &chip->sg[sgi];
+        const struct aymo_(slot_group_cold)* sgc = &chip->sg_cold[sgi];
+        sg->eg_tremolo_am = vand(chip->eg_tremolo, sgc->eg_am);
+    }
+}
+
+
+// Updates vibrato factors and frequency deltas of all slots
+AYMO_INLINE
+void aymo_(pg_update_vib)(struct aymo_(chip)* chip)
+{
+    int dvb = chip->chip_regs.reg_BDh.dvb;
+    chip->pg_vib_mulhi = vset1(aymo_(pg_vib_mulhi_table)[dvb][chip->pg_vibpos]);
+    chip->pg_vib_neg = vset1(aymo_(pg_vib_neg_table)[chip->pg_vibpos]);
+
+    // Only slot groups with vibrato enabled can change
+    chip->pg_deltafreq_dirty |= chip->pg_vib_mask;
+}
+
+
+// Updates LFO timers
+AYMO_INLINE
+void aymo_(tm_update_lfo)(struct aymo_(chip)* chip)
+{
+    // Update tremolo
+    uint16_t eg_tremolopos = (chip->eg_tremolopos + ((chip->tm_timer & 0x3F) == 0x3F));
+    eg_tremolopos = ((eg_tremolopos < 210) ? eg_tremolopos : 0);
+    if ((eg_tremolopos != chip->eg_tremolopos) || chip->eg_tremolo_refresh) {
+        chip->eg_tremolopos = (uint8_t)eg_tremolopos;
+        chip->eg_tremolo_refresh = 0;
+        aymo_(eg_update_tremolo)(chip);
+    }
+
+    // Update vibrato
+    if ((chip->tm_timer & 0x3FF) == 0x3FF) {
+        chip->pg_vibpos = ((chip->pg_vibpos + 1) & 7);
+        aymo_(pg_update_vib)(chip);
+    }
+
+    chip->tm_timer++;
+}
+
+
+// Updates timer management
+AYMO_INLINE
+void aymo_(tm_update)(struct aymo_(chip)* chip)
+{
+    aymo_(tm_update_lfo)(chip);
+
+    uint16_t eg_incstep = aymo_(eg_incstep_table)[chip->tm_timer & 3];
+    chip->eg_incstep = vi2u(vset1((int16_t)eg_incstep));
+
+    // Update timed envelope patterns
+    int16_t eg_shift = (int16_t)ffsll((long long)chip->eg_timer);
+    int16_t eg_add = ((eg_shift > 13) ? 0 : eg_shift);
+    chip->eg_add = vset1(eg_add);
+
+    // Update envelope timer and flip state
+    if (chip->eg_state || ((chip->eg_timer & AYMO_(EG_TIMER_MASK)) == 0)) {
+        chip->eg_timer = (((chip->eg_timer + 1) & AYMO_(EG_TIMER_MASK)) | AYMO_(EG_TIMER_HIBIT));
+    }
+    chip->eg_state ^= 1;
+    chip->eg_statev = vset1((int16_t)chip->eg_state);
+}
+
+
+// Computes the envelope timing schedule for the next ticks
+AYMO_INLINE
+void aymo_(tm_schedule_eg)(struct aymo_(chip)* chip, struct aymo_(eg_sched)* sched, unsigned count)
+{
+    uint64_t tm_timer = chip->tm_timer;
+    uint64_t eg_timer = chip->eg_timer;
+    int16_t eg_state = chip->eg_state;
+
+    for (unsigned k = 0; k < count; ++k) {
+        sched->eg_incstep[k] = aymo_(eg_incstep_table)[(tm_timer + 1 + k) & 3];
+
+        int16_t eg_shift = (int16_t)ffsll((long long)eg_timer);
+        sched->eg_add[k] = ((eg_shift > 13) ? 0 : eg_shift);
+
+        if (eg_state || ((eg_timer & AYMO_(EG_TIMER_MASK)) == 0)) {
+            eg_timer = (((eg_timer + 1) & AYMO_(EG_TIMER_MASK)) | AYMO_(EG_TIMER_HIBIT));
+        }
+        eg_state ^= 1;
+        sched->eg_state[k] = eg_state;
+    }
+    chip->eg_timer = eg_timer;
+    chip->eg_state = (uint8_t)eg_state;
+}
+
+
+// Updates the register queue
+AYMO_INLINE
+void aymo_(rq_update)(struct aymo_(chip)* chip)
+{
+    if (chip->rq_delay) {
+        if (--chip->rq_delay) {
+            return;
+        }
+    }
+    if (chip->rq_head != chip->rq_tail) {
+        struct aymo_(reg_queue_item)* item = &chip->rq_buffer[chip->rq_head];
+
+        if (item->address & 0x8000U) {
+            chip->rq_delay = AYMO_(REG_QUEUE_LATENCY);
+            chip->rq_delay += (((uint32_t)(item->address & 0x7FFFU) << 16) | item->value);
+        }
+        else {
+            aymo_(write)(chip, item->address, item->value);
+        }
+
+        if (++chip->rq_head >= AYMO_(REG_QUEUE_LENGTH)) {
+            chip->rq_head = 0;
+        }
+    }
+}
+
+
+// Processes the envelope and phase generators of all the slots of a single tick
+// Wave generators and outputs hold their previous values
+AYMO_STATIC
+void aymo_(tick_slots_hold)(struct aymo_(chip)* chip, struct aymo_(pg_run)* run)
+{
+    int sgi;
+    int cgi;
+
+    // Process slot group 0
+    sgi = 0;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(eg_update_lazy)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+    aymo_(pg_update_run)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+    aymo_(ng_update)(chip, 13);  // slot 0 --> slot 13
+    aymo_(rm_update_sg0)(chip);
+
+    // Process slot group 1
+    sgi = 1;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(eg_update_lazy)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+    aymo_(pg_update_run)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+    aymo_(ng_update)(chip, 3);  // slot 13 --> slot 16
+    aymo_(rm_update_sg1)(chip);
+
+    // Process slot group 2
+    sgi = 2;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(sg_update_egpg)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+
+    // Process slot group 3
+    sgi = 3;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(sg_update_egpg)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+
+    // Update noise
+    aymo_(ng_update)(chip, (36 - 16));  // slot 16 --> slot 36
+}
+
+
+// Processes all the slots of a single tick
+AYMO_INLINE
+void aymo_(tick_slots)(struct aymo_(chip)* chip, struct aymo_(pg_run)* run)
+{
+    int sgi;
+    int cgi;
+
+    // Apply pending phase increment changes
+    aymo_(pg_flush_deltafreq)(chip);
+
+    // Low-fidelity mode holds the previous outputs between wave updates
+    if (chip->tm_timer & (((uint64_t)1 << chip->process_lofi) - 1u)) {
+        aymo_(tick_slots_hold)(chip, run);
+        return;
+    }
+
+    // Clear output accumulators
+    aymo_(og_clear)(chip);
+
+    // Process slot group 0
+    sgi = 0;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(eg_update_lazy)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+    aymo_(pg_update_run)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+    aymo_(ng_update)(chip, 13);  // slot 0 --> slot 13
+    aymo_(rm_update_sg0)(chip);
+    aymo_(sg_update_wg)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+
+    // Process slot group 1
+    sgi = 1;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(eg_update_lazy)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+    aymo_(pg_update_run)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+    aymo_(ng_update)(chip, 3);  // slot 13 --> slot 16
+    aymo_(rm_update_sg1)(chip);
+    aymo_(sg_update_wg)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+
+    // Process slot group 2
+    sgi = 2;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(sg_update_egpg)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+    aymo_(sg_update_wg)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+
+    // Process slot group 3
+    sgi = 3;
+    cgi = aymo_(sgi_to_cgi)(sgi);
+    aymo_(sg_update_egpg)(chip, &chip->cg[cgi], &chip->sg[sgi], run);
+    aymo_(sg_update_wg)(chip, &chip->cg[cgi], &chip->sg[sgi]);
+
+    // Update noise
+    aymo_(ng_update)(chip, (36 - 16));  // slot 16 --> slot 36
+
+    // Update outputs
+    aymo_(og_update)(chip);
+}
+
+
+// Exceutes a single processing tick
+void aymo_(tick)(struct aymo_(chip)* chip)
+{
+    // Process slots
+    aymo_(tick_slots)(chip, NULL);
+
+    // Update timers
+    aymo_(tm_update)(chip);
+
+    // Dequeue registers
+    aymo_(rq_update)(chip);
+}
+
+
+// Buffers the per-channel outputs of a tick, from the output slots of each channel
+// Mono, before output routing and the quirky slot output delay; rhythm slots doubled
+AYMO_INLINE
+void aymo_(og_update_ch2x)(struct aymo_(chip)* chip, struct aymo_(og_ch2x_block)* blk)
+{
+    aymoi16_t og_out[AYMO_(SLOT_GROUP_NUM) / 2];
+    for (int cgi = 0; cgi < (AYMO_(SLOT_GROUP_NUM) / 2); ++cgi) {
+        og_out[cgi] = vsetz();
+    }
+    for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
+        int cgi = aymo_(sgi_to_cgi)(sgi);
+        aymoi16_t og_out_gate = vand(chip->sg_cold[sgi].og_out_gate, chip->cg[cgi].og_ch_play);
+        aymoi16_t wave_out = vand(chip->sg[sgi].wg_out, og_out_gate);
+        wave_out = vadd(wave_out, vand(wave_out, chip->sg[sgi].og_ryt_gate));
+        og_out[cgi] = vadd(og_out[cgi], wave_out);
+    }
+    for (int cgi = 0; cgi < (AYMO_(SLOT_GROUP_NUM) / 2); ++cgi) {
+        blk->og_out[cgi][blk->pos] = og_out[cgi];
+    }
+    blk->pos++;
+}
+
+
+// Strided offsets of a square matrix of words, to transpose ticks by channel
+AYMO_INLINE
+aymoi16_t aymo_(og_ch2x_stride)(void)
+{
+    return vsetr(0, 16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240);
+}
+
+
+// Transposes buffered per-channel outputs into planar stems, ych[(ch2x * total) + i]
+// Level meters are taken from the same per-channel time vectors
+AYMO_INLINE
+void aymo_(og_store_ch2x)(
+    struct aymo_(og_ch2x_block)* blk,
+    int16_t* ych,
+    uint32_t total,
+    struct aymo_(og_meters)* meters
+)
+{
+    aymoi16_t stride = aymo_(og_ch2x_stride)();
+
+    // Clear the ticks not reached by a partial block, before gathering them
+    for (int k = blk->pos; k < AYMO_(SLOT_GROUP_LENGTH); ++k) {
+        for (int cgi = 0; cgi < (AYMO_(SLOT_GROUP_NUM) / 2); ++cgi) {
+            blk->og_out[cgi][k] = vsetz();
+        }
+    }
+
+    for (int ch2x = 0; ch2x < AYMO_(CHANNEL_NUM); ++ch2x) {
+        int word = aymo_(ch2x_to_word)[ch2x][0];
+        int cgi = aymo_(sgi_to_cgi)(word / AYMO_(SLOT_GROUP_LENGTH));
+        int sgo = (word % AYMO_(SLOT_GROUP_LENGTH));
+        const int16_t* og_out = (const int16_t*)(const void*)&blk->og_out[cgi][0];
+        aymoi16_t ch_out = vgather(og_out, vadd(stride, vset1((int16_t)sgo)));
+
+        if (meters) {
+            // Peak up to 16336 from doubled rhythm slots, so 16 squares fit 32 bits
+            int peak = vhmaxabs(ch_out);
+            if (meters->peak[ch2x] < peak) {
+                meters->peak[ch2x] = (uint16_t)peak;
+            }
+            meters->energy[ch2x] += vhsumsq(ch_out);
+        }
+        if (!ych) {
+            continue;
+        }
+
+        int16_t* y = &ych[((size_t)ch2x * total) + blk->offset];
+        if (blk->pos >= AYMO_(SLOT_GROUP_LENGTH)) {
+            vstoreu(y, ch_out);
+        }
+        else {
+            for (int k = 0; k < blk->pos; ++k) {
+                y[k] = vextractn(ch_out, k);
+            }
+        }
+    }
+    blk->offset += blk->pos;
+    blk->pos = 0;
+}
+
+
+// Generates a block of samples into the destinations of a sink
+AYMO_INLINE
+void aymo_(generate)(struct aymo_(chip)* chip, uint32_t count, const struct aymo_(og_sink)* sink)
+{
+    struct aymo_(eg_sched) sched;
+    struct aymo_(pg_run) run;
+    struct aymo_(og_ch2x_block) blk;
+    uint32_t total = count;
+    int16_t* y = sink->y;
+    int32_t* mix_i32 = sink->mix_i32;
+    float* mix_f32 = sink->mix_f32;
+    int16_t* ych = sink->ych;
+    struct aymo_(og_meters)* meters = sink->meters;
+    int64_t mix_gain = sink->mix_gain;
+    float mix_gain_f32 = ((float)sink->mix_gain * (1.f / (65536.f * 32768.f)));
+
+    for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
+        run.pos[sgi] = 0;
+        run.len[sgi] = 0;
+    }
+    blk.offset = 0;
+    blk.pos = 0;
+
+    while (count) {
+        unsigned block = AYMO_(TM_BLOCK_LENGTH);
+        if (block > count) {
+            block = count;
+        }
+        aymo_(tm_schedule_eg)(chip, &sched, block);
+
+        for (unsigned k = 0; k < block; ++k) {
+            // Unsaturated sums of the delayed outputs, for mixing
+            int32_t og_del_sum_b = chip->og_sum_b;
+            int32_t og_del_sum_d = chip->og_sum_d;
+
+            aymo_(tick_slots)(chip, &run);
+
+            if (ych || meters) {
+                aymo_(og_update_ch2x)(chip, &blk);
+                if (blk.pos >= AYMO_(SLOT_GROUP_LENGTH)) {
+                    aymo_(og_store_ch2x)(&blk, ych, total, meters);
+                }
+            }
+
+            // Update timers from the schedule
+            aymo_(tm_update_lfo)(chip);
+            chip->eg_incstep = vi2u(vset1((int16_t)sched.eg_incstep[k]));
+            chip->eg_add = vset1(sched.eg_add[k]);
+            chip->eg_statev = vset1(sched.eg_state[k]);
+
+            aymo_(rq_update)(chip);
+
+            if (y) {
+                y[0] = chip->og_out_a;
+                y[1] = chip->og_out_b;
+                y[2] = chip->og_out_c;
+                y[3] = chip->og_out_d;
+                y += 4;
+            }
+            if (mix_i32) {
+                mix_i32[0] += (int32_t)((chip->og_sum_a * mix_gain) >> 16);
+                mix_i32[1] += (int32_t)((og_del_sum_b * mix_gain) >> 16);
+                mix_i32[2] += (int32_t)((chip->og_sum_c * mix_gain) >> 16);
+                mix_i32[3] += (int32_t)((og_del_sum_d * mix_gain) >> 16);
+                mix_i32 += 4;
+            }
+            if (mix_f32) {
+                mix_f32[0] += ((float)chip->og_sum_a * mix_gain_f32);
+                mix_f32[1] += ((float)og_del_sum_b * mix_gain_f32);
+                mix_f32[2] += ((float)chip->og_sum_c * mix_gain_f32);
+                mix_f32[3] += ((float)og_del_sum_d * mix_gain_f32);
+                mix_f32 += 4;
+            }
+        }
+        count -= block;
+    }
+    if ((ych || meters) && blk.pos) {
+        aymo_(og_store_ch2x)(&blk, ych, total, meters);
+    }
+
+    for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
+        aymo_(pg_run_sync)(&chip->sg[sgi], &run, sgi);
+    }
+}
+
+
+// Generates a block of samples, with the 4 output channels interleaved
+void aymo_(generate_i16x4)(struct aymo_(chip)* chip, uint32_t count, int16_t* y)
+{
+    struct aymo_(og_sink) sink = { y, NULL, NULL, NULL, NULL, 0 };
+    aymo_(generate)(chip, count, &sink);
+}
+
+
+// Generates a block of samples, plus planar stems of all the Channel_2xOP outputs
+// Stems are stored as ych[(ch2x * count) + i], for ch2x < CHANNEL_NUM
+void aymo_(generate_i16x4_ch2x)(struct aymo_(chip)* chip, uint32_t count, int16_t* y, int16_t* ych)
+{
+    struct aymo_(og_sink) sink = { y, NULL, NULL, ych, NULL, 0 };
+    aymo_(generate)(chip, count, &sink);
+}
+
+
+// Generates a block of samples, plus level meters of all the Channel_2xOP outputs
+// Meters are reset at each call; RMS is sqrt(energy / count)
+void aymo_(generate_i16x4_meters)(struct aymo_(chip)* chip, uint32_t count, int16_t* y, struct aymo_(og_meters)* meters)
+{
+    for (int ch2x = 0; ch2x < AYMO_(CHANNEL_NUM); ++ch2x) {
+        meters->energy[ch2x] = 0;
+        meters->peak[ch2x] = 0;
+    }
+    meters->count = count;
+    struct aymo_(og_sink) sink = { y, NULL, NULL, NULL, meters, 0 };
+    aymo_(generate)(chip, count, &sink);
+}
+
+
+// Generates a block of samples, accumulated into a 32-bit mix bus with 4 channels interleaved
+// The gain is 16.16 fixed point; saturation is left to the owner of the mix bus
+void aymo_(generate_mix_i32x4)(struct aymo_(chip)* chip, uint32_t count, int32_t* y, int32_t gain)
+{
+    struct aymo_(og_sink) sink = { NULL, y, NULL, NULL, NULL, gain };
+    aymo_(generate)(chip, count, &sink);
+}
+
 
-        // Update TC
-        uint32_t phase17 = vextract(phase, 10);
-        chip->rm_tc_bit3 = ((phase17 >> 3) & 1);
-        chip->rm_tc_bit5 = ((phase17 >> 5) & 1);
-        phase17 = ((rm_xor << 9) | 0x80);
-        phase = vinsert(phase, (int16_t)phase17, 10);
+// Generates a block of samples, accumulated into a float mix bus with 4 channels interleaved
+// The gain is 16.16 fixed point, with 16-bit full scale mapped to 1.0
+void aymo_(generate_mix_f32x4)(struct aymo_(chip)* chip, uint32_t count, float* y, int32_t gain)
+{
+    struct aymo_(og_sink) sink = { NULL, NULL, y, NULL, NULL, gain };
+    aymo_(generate)(chip, count, &sink);
+}
 
-        sg->pg_phase_out = phase;
+
+// Downmixes 4 interleaved output channels into 2, as a+c and b+d, saturated
+// Counts frames; can work in place
+void aymo_(convert_i16x4_i16x2)(uint32_t count, const int16_t* x, int16_t* y)
+{
+    uint32_t i = 0;
+    for (; (i + (AYMO_(SLOT_GROUP_LENGTH) / 2)) <= count; i += (AYMO_(SLOT_GROUP_LENGTH) / 2)) {
+        aymoi16_t x0 = vloadu(&x[i * 4]);
+        aymoi16_t x1 = vloadu(&x[(i * 4) + AYMO_(SLOT_GROUP_LENGTH)]);
+        vstoreu(&y[i * 2], vmix4to2(x0, x1));
+    }
+    for (; i < count; ++i) {
+        int16_t l = clamp16(x[(i * 4) + 0] + x[(i * 4) + 2]);
+        int16_t r = clamp16(x[(i * 4) + 1] + x[(i * 4) + 3]);
+        y[(i * 2) + 0] = l;
+        y[(i * 2) + 1] = r;
     }
 }
 
 
-// Updates slot generators
-AYMO_STATIC
-void aymo_(sg_update)(
-    struct aymo_(chip)* chip,
-    struct aymo_(ch2x_group)* cg,
-    struct aymo_(slot_group)* sg
-)
+// Converts 16-bit samples into packed 24-bit little-endian samples
+// Counts samples, whatever the number of channels
+void aymo_(convert_i16_i24)(uint32_t count, const int16_t* x, uint8_t* y)
 {
-    aymo_(eg_update)(chip, cg, sg);
-    aymo_(pg_update)(chip, cg, sg);
-    aymo_(wg_update)(chip, cg, sg);
+    uint32_t i = 0;
+    for (; (i + AYMO_(SLOT_GROUP_LENGTH)) <= count; i += AYMO_(SLOT_GROUP_LENGTH)) {
+        vstore24(&y[i * 3], vloadu(&x[i]));
+    }
+    for (; i < count; ++i) {
+        uint16_t u = (uint16_t)x[i];
+        y[(i * 3) + 0] = 0;
+        y[(i * 3) + 1] = (uint8_t)u;
+        y[(i * 3) + 2] = (uint8_t)(u >> 8);
+    }
 }
 
 
-// Clear output accumulators
-AYMO_INLINE
-void aymo_(og_clear)(struct aymo_(chip)* chip)
+// Converts 16-bit samples into 32-bit samples, keeping full scale
+// Counts samples, whatever the number of channels
+void aymo_(convert_i16_i32)(uint32_t count, const int16_t* x, int32_t* y)
 {
-    chip->og_acc_a = vsetz();
-    chip->og_acc_b = vsetz();
-    chip->og_acc_c = vsetz();
-    chip->og_acc_d = vsetz();
+    uint32_t i = 0;
+    for (; (i + AYMO_(SLOT_GROUP_LENGTH)) <= count; i += AYMO_(SLOT_GROUP_LENGTH)) {
+        aymoi16_t v = vloadu(&x[i]);
+        vvstoreu(&y[i], vvslli(vvunpacklo(v), 16));
+        vvstoreu(&y[i + (AYMO_(SLOT_GROUP_LENGTH) / 2)], vvslli(vvunpackhi(v), 16));
+    }
+    for (; i < count; ++i) {
+        y[i] = (int32_t)((uint32_t)(int32_t)x[i] << 16);
+    }
 }
 
 
-// Updates output mixdown
-AYMO_INLINE
-void aymo_(og_update)(struct aymo_(chip)* chip)
+// Converts 16-bit samples into float samples, with full scale mapped to 1.0
+// Counts samples, whatever the number of channels
+void aymo_(convert_i16_f32)(uint32_t count, const int16_t* x, float* y)
 {
-    chip->og_sum_a = vhsum(chip->og_acc_a);
-    chip->og_sum_b = vhsum(chip->og_acc_b);
-    chip->og_sum_c = vhsum(chip->og_acc_c);
-    chip->og_sum_d = vhsum(chip->og_acc_d);
-
-    chip->og_out_a = clamp16(chip->og_sum_a);
-    chip->og_out_b = chip->og_del_b;
-    chip->og_del_b = clamp16(chip->og_sum_b);
-    chip->og_out_c = clamp16(chip->og_sum_c);
-    chip->og_out_d = chip->og_del_d;
-    chip->og_del_d = clamp16(chip->og_sum_d);
+    const float scale = (1.f / 32768.f);
+    aymof32_t vscale = vfset1(scale);
+    uint32_t i = 0;
+    for (; (i + AYMO_(SLOT_GROUP_LENGTH)) <= count; i += AYMO_(SLOT_GROUP_LENGTH)) {
+        aymoi16_t v = vloadu(&x[i]);
+        vfstoreu(&y[i], vfmul(vfcvt(vvunpacklo(v)), vscale));
+        vfstoreu(&y[i + (AYMO_(SLOT_GROUP_LENGTH) / 2)], vfmul(vfcvt(vvunpackhi(v)), vscale));
+    }
+    for (; i < count; ++i) {
+        y[i] = ((float)x[i] * scale);
+    }
 }
 
 
-// Updates timer management
-AYMO_INLINE
-void aymo_(tm_update)(struct aymo_(chip)* chip)
+// Polyphase FIR coefficients, Kaiser-windowed sinc (beta 7.5, 19 kHz cutoff), Q15
+// Rows are fractional delays, plus a closing row for interpolation; each row sums to 1.0
+AYMO_STATIC AYMO_ALIGN_V16
+const int16_t aymo_(rs_poly_table)[AYMO_(RS_PHASES) + 1][AYMO_(RS_TAPS)] =
 {
-    // Update tremolo
-    if ((chip->tm_timer & 0x3F) == 0x3F) {
-        chip->eg_tremolopos = ((chip->eg_tremolopos + 1) % 210);
+    {  // 0 / 64
+            -9,     18,     -9,    -44,    138,   -206,    129,    181,
+          -659,   1008,   -782,   -375,   2445,  -4918,   6941,  25050,
+          6941,  -4918,   2445,   -375,   -782,   1008,   -659,    181,
+           129,   -206,    138,    -44,     -9,     18,     -9,      2
+    },
+    {  // 1 / 64
+            -9,     18,     -7,    -46,    138,   -201,    116,    198,
+          -668,    992,   -731,   -449,   2497,  -4855,   6546,  25042,
+          7339,  -4974,   2389,   -299,   -833,   1023,   -650,    164,
+           142,   -211,    137,    -41,    -11,     19,     -9,      2
+    },
+    {  // 2 / 64
+            -9,     17,     -6,    -48,    138,   -195,    103,    215,
+          -675,    974,   -679,   -522,   2545,  -4787,   6154,  25023,
+          7739,  -5024,   2329,   -222,   -883,   1037,   -639,    147,
+           155,   -216,    136,    -39,    -13,     20,     -9,      2
+    },
+    {  // 3 / 64
+            -9,     16,     -4,    -50,    138,   -190,     91,    230,
+          -681,    955,   -627,   -593,   2588,  -4714,   5765,  24997,
+          8141,  -5068,   2265,   -144,   -932,   1050,   -628,    128,
+           168,   -221,    135,    -36,    -15,     21,    -10,      2
+    },
+    {  // 4 / 64
+            -9,     15,     -2,    -52,    138,   -184,     78,    246,
+          -687,    935,   -574,   -663,   2627,  -4634,   5381,  24952,
+          8546,  -5105,   2197,    -64,   -980,   1061,   -615,    110,
+           181,   -225,    134,    -34,    -17,     21,    -10,      1
+    },
+    {  // 5 / 64
+            -9,     15,     -1,    -54,    138,   -178,     65,    260,
+          -691,    914,   -522,   -731,   2662,  -4550,   5000,  24901,
+          8952,  -5136,   2124,     16,  -1028,   1071,   -602,     91,
+           194,   -229,    133,    -31,    -19,     22,    -10,      1
+    },
+    {  // 6 / 64
+            -8,     14,      1,    -56,    137,   -171,     52,    275,
+          -694,    891,   -469,   -797,   2693,  -4461,   4623,  24834,
+          9359,  -5159,   2048,     97,  -1075,   1079,   -587,     72,
+           206,   -233,    131,    -28,    -20,     23,    -10,      1
+    },
+    {  // 7 / 64
+            -8,     13,      3,    -58,    136,   -165,     39,    288,
+          -696,    868,   -416,   -861,   2719,  -4366,   4251,  24757,
+          9768,  -5176,   1967,    179,  -1120,   1086,   -571,     52,
+           219,   -236,    129,    -25,    -22,     23,    -10,      1
+    },
+    {  // 8 / 64
+            -8,     12,      4,    -59,    135,   -158,     26,    301,
+          -697,    844,   -362,   -923,   2741,  -4267,   3883,  24669,
+         10177,  -5186,   1883,    262,  -1165,   1091,   -555,     32,
+           231,   -239,    127,    -22,    -24,     24,    -10,      1
+    },
+    {  // 9 / 64
+            -8,     12,      6,    -61,    134,   -152,     14,    314,
+          -697,    818,   -309,   -984,   2759,  -4164,   3521,  24568,
+         10587,  -5188,   1795,    345,  -1208,   1095,   -537,     12,
+           243,   -242,    125,    -19,    -26,     24,    -10,      1
+    },
+    {  // 10 / 64
+            -8,     11,      7,    -62,    133,   -145,      2,    326,
+          -697,    792,   -257,  -1042,   2773,  -4057,   3163,  24459,
+         10996,  -5183,   1703,    429,  -1250,   1097,   -519,     -8,
+           255,   -245,    122,    -15,    -28,     25,    -10,      1
+    },
+    {  // 11 / 64
+            -7,     10,      9,    -63,    131,   -138,    -11,    337,
+          -695,    765,   -204,  -1098,   2783,  -3945,   2811,  24334,
+         11406,  -5170,   1607,    513,  -1290,   1098,   -499,    -29,
+           266,   -247,    119,    -12,    -30,     26,    -10,      1
+    },
+    {  // 12 / 64
+            -7,      9,     10,    -64,    129,   -131,    -23,    348,
+          -692,    737,   -151,  -1152,   2789,  -3830,   2465,  24200,
+         11814,  -5149,   1508,    597,  -1330,   1097,   -478,    -49,
+           278,   -249,    116,     -9,    -32,     26,    -10,      1
+    },
+    {  // 13 / 64
+            -7,      8,     12,    -65,    127,   -124,    -35,    358,
+          -688,    709,    -99,  -1203,   2790,  -3711,   2124,  24052,
+         12222,  -5121,   1405,    681,  -1367,   1095,   -457,    -70,
+           289,   -250,    113,     -5,    -34,     27,     -9,      1
+    },
+    {  // 14 / 64
+            -7,      8,     13,    -66,    125,   -116,    -46,    367,
+          -683,    679,    -48,  -1253,   2788,  -3589,   1790,  23895,
+         12629,  -5085,   1299,    766,  -1403,   1091,   -435,    -92,
+           300,   -251,    110,     -1,    -36,     27,     -9,      1
+    },
+    {  // 15 / 64
+            -6,      7,     14,    -67,    123,   -109,    -58,    376,
+          -678,    649,      4,  -1300,   2782,  -3463,   1462,  23730,
+         13034,  -5041,   1189,    850,  -1438,   1085,   -412,   -113,
+           310,   -252,    106,      2,    -37,     27,     -9,      1
+    },
+    {  // 16 / 64
+            -6,      6,     15,    -67,    121,   -102,    -69,    384,
+          -671,    619,     54,  -1344,   2772,  -3335,   1140,  23550,
+         13438,  -4988,   1076,    934,  -1471,   1078,   -387,   -134,
+           320,   -253,    102,      6,    -39,     28,     -9,      0
+    },
+    {  // 17 / 64
+            -6,      5,     17,    -68,    118,    -94,    -80,    391,
+          -663,    588,    104,  -1387,   2758,  -3204,    825,  23363,
+         13839,  -4928,    960,   1018,  -1502,   1069,   -363,   -155,
+           330,   -253,     98,     10,    -41,     28,     -9,      0
+    },
+    {  // 18 / 64
+            -6,      5,     18,    -68,    116,    -87,    -91,    398,
+          -655,    556,    154,  -1427,   2740,  -3070,    517,  23162,
+         14238,  -4859,    842,   1101,  -1531,   1058,   -337,   -177,
+           340,   -252,     94,     13,    -43,     28,     -9,      0
+    },
+    {  // 19 / 64
+            -6,      4,     19,    -68,    113,    -79,   -101,    404,
+          -646,    524,    202,  -1464,   2719,  -2934,    216,  22949,
+         14634,  -4781,    720,   1184,  -1558,   1046,   -310,   -198,
+           349,   -252,     89,     17,    -45,     29,     -8,      0
+    },
+    {  // 20 / 64
+            -5,      3,     20,    -69,    110,    -72,   -111,    410,
+          -636,    491,    250,  -1499,   2694,  -2796,    -78,  22731,
+         15027,  -4696,    595,   1266,  -1584,   1032,   -283,   -220,
+           358,   -251,     85,     21,    -46,     29,     -8,      0
+    },
+    {  // 21 / 64
+            -5,      3,     21,    -69,    107,    -65,   -121,    415,
+          -625,    458,    297,  -1531,   2665,  -2657,   -365,  22502,
+         15416,  -4602,    468,   1347,  -1607,   1017,   -255,   -241,
+           366,   -249,     80,     25,    -48,     29,     -8,      0
+    },
+    {  // 22 / 64
+            -5,      2,     22,    -69,    104,    -57,   -131,    419,
+          -613,    425,    343,  -1561,   2633,  -2515,   -644,  22263,
+         15802,  -4499,    339,   1427,  -1629,   1000,   -227,   -262,
+           374,   -248,     75,     29,    -50,     29,     -8,      0
+    },
+    {  // 23 / 64
+            -5,      1,     23,    -68,    101,    -50,   -140,    422,
+          -601,    392,    388,  -1588,   2598,  -2373,   -915,  22014,
+         16183,  -4387,    207,   1506,  -1648,    981,   -198,   -283,
+           381,   -245,     69,     33,    -51,     29,     -7,     -1
+    },
+    {  // 24 / 64
+            -4,      1,     23,    -68,     98,    -42,   -149,    425,
+          -588,    358,    432,  -1613,   2560,  -2229,  -1179,  21756,
+         16560,  -4267,     73,   1583,  -1665,    961,   -168,   -304,
+           388,   -243,     64,     37,    -53,     29,     -7,     -1
+    },
+    {  // 25 / 64
+            -4,      0,     24,    -68,     94,    -35,   -158,    427,
+          -574,    324,    475,  -1635,   2518,  -2084,  -1435,  21490,
+         16933,  -4139,    -63,   1660,  -1680,    939,   -137,   -325,
+           395,   -240,     58,     41,    -54,     29,     -7,     -1
+    },
+    {  // 26 / 64
+            -4,     -1,     25,    -67,     91,    -28,   -166,    429,
+          -560,    291,    517,  -1655,   2473,  -1938,  -1682,  21212,
+         17300,  -4002,   -201,   1734,  -1692,    915,   -107,   -345,
+           401,   -236,     53,     45,    -56,     29,     -6,     -1
+    },
+    {  // 27 / 64
+            -4,     -1,     26,    -67,     87,    -20,   -174,    430,
+          -545,    257,    558,  -1672,   2425,  -1792,  -1922,  20927,
+         17662,  -3855,   -341,   1808,  -1703,    890,    -75,   -365,
+           406,   -233,     47,     49,    -57,     29,     -6,     -1
+    },
+    {  // 28 / 64
+            -3,     -2,     26,    -66,     84,    -13,   -181,    430,
+          -529,    223,    597,  -1686,   2375,  -1645,  -2153,  20631,
+         18019,  -3701,   -482,   1879,  -1710,    863,    -43,   -385,
+           411,   -228,     41,     53,    -58,     29,     -6,     -2
+    },
+    {  // 29 / 64
+            -3,     -2,     27,    -66,     80,     -6,   -189,    430,
+          -513,    189,    635,  -1698,   2321,  -1498,  -2377,  20333,
+         18369,  -3537,   -625,   1949,  -1716,    835,    -11,   -404,
+           416,   -224,     34,     57,    -60,     29,     -5,     -2
+    },
+    {  // 30 / 64
+            -3,     -3,     27,    -65,     76,      1,   -195,    429,
+          -496,    155,    672,  -1707,   2265,  -1351,  -2591,  20023,
+         18714,  -3365,   -768,   2016,  -1719,    805,     22,   -424,
+           419,   -219,     28,     61,    -61,     29,     -5,     -2
+    },
+    {  // 31 / 64
+            -3,     -3,     28,    -64,     72,      8,   -202,    428,
+          -478,    121,    707,  -1714,   2206,  -1205,  -2798,  19707,
+         19052,  -3185,   -913,   2082,  -1720,    774,     55,   -442,
+           423,   -214,     21,     65,    -62,     28,     -4,     -2
+    },
+    {  // 32 / 64
+            -2,     -4,     28,    -63,     68,     15,   -208,    425,
+          -461,     88,    741,  -1718,   2145,  -1059,  -2995,  19385,
+         19383,  -2995,  -1059,   2145,  -1718,    741,     88,   -461,
+           425,   -208,     15,     68,    -63,     28,     -4,     -2
+    },
+    {  // 33 / 64
+            -2,     -4,     28,    -62,     65,     21,   -214,    423,
+          -442,     55,    774,  -1720,   2082,   -913,  -3185,  19052,
+         19707,  -2798,  -1205,   2206,  -1714,    707,    121,   -478,
+           428,   -202,      8,     72,    -64,     28,     -3,     -3
+    },
+    {  // 34 / 64
+            -2,     -5,     29,    -61,     61,     28,   -219,    419,
+          -424,     22,    805,  -1719,   2016,   -768,  -3365,  18714,
+         20023,  -2591,  -1351,   2265,  -1707,    672,    155,   -496,
+           429,   -195,      1,     76,    -65,     27,     -3,     -3
+    },
+    {  // 35 / 64
+            -2,     -5,     29,    -60,     57,     34,   -224,    416,
+          -404,    -11,    835,  -1716,   1949,   -625,  -3537,  18369,
+         20333,  -2377,  -1498,   2321,  -1698,    635,    189,   -513,
+           430,   -189,     -6,     80,    -66,     27,     -2,     -3
+    },
+    {  // 36 / 64
+            -2,     -6,     29,    -58,     53,     41,   -228,    411,
+          -385,    -43,    863,  -1710,   1879,   -482,  -3701,  18019,
+         20631,  -2153,  -1645,   2375,  -1686,    597,    223,   -529,
+           430,   -181,    -13,     84,    -66,     26,     -2,     -3
+    },
+    {  // 37 / 64
+            -1,     -6,     29,    -57,     49,     47,   -233,    406,
+          -365,    -75,    890,  -1703,   1808,   -341,  -3855,  17662,
+         20927,  -1922,  -1792,   2425,  -1672,    558,    257,   -545,
+           430,   -174,    -20,     87,    -67,     26,     -1,     -4
+    },
+    {  // 38 / 64
+            -1,     -6,     29,    -56,     45,     53,   -236,    401,
+          -345,   -107,    915,  -1692,   1734,   -201,  -4002,  17300,
+         21212,  -1682,  -1938,   2473,  -1655,    517,    291,   -560,
+           429,   -166,    -28,     91,    -67,     25,     -1,     -4
+    },
+    {  // 39 / 64
+            -1,     -7,     29,    -54,     41,     58,   -240,    395,
+          -325,   -137,    939,  -1680,   1660,    -63,  -4139,  16933,
+         21490,  -1435,  -2084,   2518,  -1635,    475,    324,   -574,
+           427,   -158,    -35,     94,    -68,     24,      0,     -4
+    },
+    {  // 40 / 64
+            -1,     -7,     29,    -53,     37,     64,   -243,    388,
+          -304,   -168,    961,  -1665,   1583,     73,  -4267,  16560,
+         21756,  -1179,  -2229,   2560,  -1613,    432,    358,   -588,
+           425,   -149,    -42,     98,    -68,     23,      1,     -4
+    },
+    {  // 41 / 64
+            -1,     -7,     29,    -51,     33,     69,   -245,    381,
+          -283,   -198,    981,  -1648,   1506,    207,  -4387,  16183,
+         22014,   -915,  -2373,   2598,  -1588,    388,    392,   -601,
+           422,   -140,    -50,    101,    -68,     23,      1,     -5
+    },
+    {  // 42 / 64
+             0,     -8,     29,    -50,     29,     75,   -248,    374,
+          -262,   -227,   1000,  -1629,   1427,    339,  -4499,  15802,
+         22263,   -644,  -2515,   2633,  -1561,    343,    425,   -613,
+           419,   -131,    -57,    104,    -69,     22,      2,     -5
+    },
+    {  // 43 / 64
+             0,     -8,     29,    -48,     25,     80,   -249,    366,
+          -241,   -255,   1017,  -1607,   1347,    468,  -4602,  15416,
+         22502,   -365,  -2657,   2665,  -1531,    297,    458,   -625,
+           415,   -121,    -65,    107,    -69,     21,      3,     -5
+    },
+    {  // 44 / 64
+             0,     -8,     29,    -46,     21,     85,   -251,    358,
+          -220,   -283,   1032,  -1584,   1266,    595,  -4696,  15027,
+         22731,    -78,  -2796,   2694,  -1499,    250,    491,   -636,
+           410,   -111,    -72,    110,    -69,     20,      3,     -5
+    },
+    {  // 45 / 64
+             0,     -8,     29,    -45,     17,     89,   -252,    349,
+          -198,   -310,   1046,  -1558,   1184,    720,  -4781,  14634,
+         22949,    216,  -2934,   2719,  -1464,    202,    524,   -646,
+           404,   -101,    -79,    113,    -68,     19,      4,     -6
+    },
+    {  // 46 / 64
+             0,     -9,     28,    -43,     13,     94,   -252,    340,
+          -177,   -337,   1058,  -1531,   1101,    842,  -4859,  14238,
+         23162,    517,  -3070,   2740,  -1427,    154,    556,   -655,
+           398,    -91,    -87,    116,    -68,     18,      5,     -6
+    },
+    {  // 47 / 64
+             0,     -9,     28,    -41,     10,     98,   -253,    330,
+          -155,   -363,   1069,  -1502,   1018,    960,  -4928,  13839,
+         23363,    825,  -3204,   2758,  -1387,    104,    588,   -663,
+           391,    -80,    -94,    118,    -68,     17,      5,     -6
+    },
+    {  // 48 / 64
+             0,     -9,     28,    -39,      6,    102,   -253,    320,
+          -134,   -387,   1078,  -1471,    934,   1076,  -4988,  13438,
+         23550,   1140,  -3335,   2772,  -1344,     54,    619,   -671,
+           384,    -69,   -102,    121,    -67,     15,      6,     -6
+    },
+    {  // 49 / 64
+             1,     -9,     27,    -37,      2,    106,   -252,    310,
+          -113,   -412,   1085,  -1438,    850,   1189,  -5041,  13034,
+         23730,   1462,  -3463,   2782,  -1300,      4,    649,   -678,
+           376,    -58,   -109,    123,    -67,     14,      7,     -6
+    },
+    {  // 50 / 64
+             1,     -9,     27,    -36,     -1,    110,   -251,    300,
+           -92,   -435,   1091,  -1403,    766,   1299,  -5085,  12629,
+         23895,   1790,  -3589,   2788,  -1253,    -48,    679,   -683,
+           367,    -46,   -116,    125,    -66,     13,      8,     -7
+    },
+    {  // 51 / 64
+             1,     -9,     27,    -34,     -5,    113,   -250,    289,
+           -70,   -457,   1095,  -1367,    681,   1405,  -5121,  12222,
+         24052,   2124,  -3711,   2790,  -1203,    -99,    709,   -688,
+           358,    -35,   -124,    127,    -65,     12,      8,     -7
+    },
+    {  // 52 / 64
+             1,    -10,     26,    -32,     -9,    116,   -249,    278,
+           -49,   -478,   1097,  -1330,    597,   1508,  -5149,  11814,
+         24200,   2465,  -3830,   2789,  -1152,   -151,    737,   -692,
+           348,    -23,   -131,    129,    -64,     10,      9,     -7
+    },
+    {  // 53 / 64
+             1,    -10,     26,    -30,    -12,    119,   -247,    266,
+           -29,   -499,   1098,  -1290,    513,   1607,  -5170,  11406,
+         24334,   2811,  -3945,   2783,  -1098,   -204,    765,   -695,
+           337,    -11,   -138,    131,    -63,      9,     10,     -7
+    },
+    {  // 54 / 64
+             1,    -10,     25,    -28,    -15,    122,   -245,    255,
+            -8,   -519,   1097,  -1250,    429,   1703,  -5183,  10996,
+         24459,   3163,  -4057,   2773,  -1042,   -257,    792,   -697,
+           326,      2,   -145,    133,    -62,      7,     11,     -8
+    },
+    {  // 55 / 64
+             1,    -10,     24,    -26,    -19,    125,   -242,    243,
+            12,   -537,   1095,  -1208,    345,   1795,  -5188,  10587,
+         24568,   3521,  -4164,   2759,   -984,   -309,    818,   -697,
+           314,     14,   -152,    134,    -61,      6,     12,     -8
+    },
+    {  // 56 / 64
+             1,    -10,     24,    -24,    -22,    127,   -239,    231,
+            32,   -555,   1091,  -1165,    262,   1883,  -5186,  10177,
+         24669,   3883,  -4267,   2741,   -923,   -362,    844,   -697,
+           301,     26,   -158,    135,    -59,      4,     12,     -8
+    },
+    {  // 57 / 64
+             1,    -10,     23,    -22,    -25,    129,   -236,    219,
+            52,   -571,   1086,  -1120,    179,   1967,  -5176,   9768,
+         24757,   4251,  -4366,   2719,   -861,   -416,    868,   -696,
+           288,     39,   -165,    136,    -58,      3,     13,     -8
+    },
+    {  // 58 / 64
+             1,    -10,     23,    -20,    -28,    131,   -233,    206,
+            72,   -587,   1079,  -1075,     97,   2048,  -5159,   9359,
+         24834,   4623,  -4461,   2693,   -797,   -469,    891,   -694,
+           275,     52,   -171,    137,    -56,      1,     14,     -8
+    },
+    {  // 59 / 64
+             1,    -10,     22,    -19,    -31,    133,   -229,    194,
+            91,   -602,   1071,  -1028,     16,   2124,  -5136,   8952,
+         24901,   5000,  -4550,   2662,   -731,   -522,    914,   -691,
+           260,     65,   -178,    138,    -54,     -1,     15,     -9
+    },
+    {  // 60 / 64
+             1,    -10,     21,    -17,    -34,    134,   -225,    181,
+           110,   -615,   1061,   -980,    -64,   2197,  -5105,   8546,
+         24952,   5381,  -4634,   2627,   -663,   -574,    935,   -687,
+           246,     78,   -184,    138,    -52,     -2,     15,     -9
+    },
+    {  // 61 / 64
+             2,    -10,     21,    -15,    -36,    135,   -221,    168,
+           128,   -628,   1050,   -932,   -144,   2265,  -5068,   8141,
+         24997,   5765,  -4714,   2588,   -593,   -627,    955,   -681,
+           230,     91,   -190,    138,    -50,     -4,     16,     -9
+    },
+    {  // 62 / 64
+             2,     -9,     20,    -13,    -39,    136,   -216,    155,
+           147,   -639,   1037,   -883,   -222,   2329,  -5024,   7739,
+         25023,   6154,  -4787,   2545,   -522,   -679,    974,   -675,
+           215,    103,   -195,    138,    -48,     -6,     17,     -9
+    },
+    {  // 63 / 64
+             2,     -9,     19,    -11,    -41,    137,   -211,    142,
+           164,   -650,   1023,   -833,   -299,   2389,  -4974,   7339,
+         25042,   6546,  -4855,   2497,   -449,   -731,    992,   -668,
+           198,    116,   -201,    138,    -46,     -7,     18,     -9
+    },
+    {  // 64 / 64
+             2,     -9,     18,     -9,    -44,    138,   -206,    129,
+           181,   -659,   1008,   -782,   -375,   2445,  -4918,   6941,
+         25050,   6941,  -4918,   2445,   -375,   -782,   1008,   -659,
+           181,    129,   -206,    138,    -44,     -9,     18,     -9
+    }
+};
+
 
-        uint16_t eg_tremolopos = chip->eg_tremolopos;
-        if (eg_tremolopos >= 105) {
-            eg_tremolopos = (210 - eg_tremolopos);
+// Initializes a polyphase FIR resampler, to an output rate above SAMPLE_RATE / 2
+// Aliasing is best kept below audibility for output rates from 44100 Hz up
+void aymo_(rs_poly_init)(struct aymo_(rs_poly)* rs, uint32_t rate_out)
+{
+    for (int c = 0; c < 4; ++c) {
+        for (int k = 0; k < (AYMO_(RS_BLOCK_LENGTH) + AYMO_(RS_TAPS)); ++k) {
+            rs->hist[c][k] = 0;
         }
-        aymoi16_t eg_tremolo = vset1((int16_t)(eg_tremolopos >> chip->eg_tremoloshift));
+    }
+    rs->rate_out = rate_out;
+    rs->frac = 0;
+    rs->pos = 0;
+    rs->len = ((AYMO_(RS_TAPS) / 2) - 1);  // centers the first output frame on the first input frame
+}
 
-        for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
-            struct aymo_(slot_group)* sg = &chip->sg[sgi];
-            sg->eg_tremolo_am = vand(eg_tremolo, sg->eg_am);
+
+// Computes an output frame at the current position, interpolating between two phases
+AYMO_INLINE
+void aymo_(rs_poly_frame)(const struct aymo_(rs_poly)* rs, int16_t* y)
+{
+    uint32_t phase = (uint32_t)((((uint64_t)rs->frac * AYMO_(RS_PHASES)) << 16) / rs->rate_out);
+    int64_t t = (phase & 0xFFFF);
+    const int16_t* h0 = &aymo_(rs_poly_table)[phase >> 16][0];
+    const int16_t* h1 = &aymo_(rs_poly_table)[(phase >> 16) + 1][0];
+
+    for (int c = 0; c < 4; ++c) {
+        const int16_t* x = &rs->hist[c][rs->pos];
+        aymoi32_t acc0 = vvsetz();
+        aymoi32_t acc1 = vvsetz();
+        for (int k = 0; k < AYMO_(RS_TAPS); k += AYMO_(SLOT_GROUP_LENGTH)) {
+            aymoi16_t xk = vloadu(&x[k]);
+            acc0 = vvadd(acc0, vvmadd(xk, vloadu(&h0[k])));
+            acc1 = vvadd(acc1, vvmadd(xk, vloadu(&h1[k])));
         }
+        int32_t y0 = vvhsum(acc0);
+        int32_t y1 = vvhsum(acc1);
+        int64_t yt = (y0 + ((((int64_t)y1 - y0) * t) >> 16));
+        y[c] = clamp16((int32_t)((yt + (1 << 14)) >> 15));
     }
+}
 
-    // Update vibrato
-    if ((chip->tm_timer & 0x3FF) == 0x3FF) {
-        chip->pg_vibpos = ((chip->pg_vibpos + 1) & 7);
-        uint8_t vibpos = chip->pg_vibpos;
-        int16_t pg_vib_mulhi = (0x10000 >> 7);
-        int16_t pg_vib_neg = 0;
 
-        if (!(vibpos & 3)) {
-            pg_vib_mulhi = 0;
+// Resamples interleaved 4-channel frames, returning the number of output frames
+// The output must have room for ((count * rate_out) / SAMPLE_RATE) + 2 frames
+uint32_t aymo_(rs_poly_process)(struct aymo_(rs_poly)* rs, uint32_t count, const int16_t* x, int16_t* y)
+{
+    uint32_t done = 0;
+
+    while (count) {
+        // Append input frames to the planar history
+        uint32_t n = ((AYMO_(RS_BLOCK_LENGTH) + AYMO_(RS_TAPS)) - rs->len);
+        if (n > count) {
+            n = count;
         }
-        else if (vibpos & 1) {
-            pg_vib_mulhi >>= 1;
+        for (uint32_t i = 0; i < n; ++i) {
+            for (int c = 0; c < 4; ++c) {
+                rs->hist[c][rs->len + i] = x[(i * 4) + c];
+            }
         }
-        pg_vib_mulhi >>= chip->eg_vibshift;
-        pg_vib_mulhi &= 0x7F80;
-
-        if (vibpos & 4) {
-            pg_vib_neg = -1;
+        rs->len += n;
+        x += (n * 4);
+        count -= n;
+
+        // Filter while the taps are covered
+        while ((rs->pos + AYMO_(RS_TAPS)) <= rs->len) {
+            aymo_(rs_poly_frame)(rs, y);
+            y += 4;
+            done++;
+
+            rs->frac += AYMO_(SAMPLE_RATE);
+            rs->pos += (rs->frac / rs->rate_out);
+            rs->frac %= rs->rate_out;
         }
-        chip->pg_vib_mulhi = vset1(pg_vib_mulhi);
-        chip->pg_vib_neg = vset1(pg_vib_neg);
 
-        for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
-            int cgi = aymo_(sgi_to_cgi)(sgi);
-            struct aymo_(ch2x_group)* cg = &chip->cg[cgi];
-            struct aymo_(slot_group)* sg = &chip->sg[sgi];
-            aymo_(pg_update_deltafreq)(chip, cg, sg);
+        // Keep only the history still needed
+        uint32_t keep = ((rs->pos < rs->len) ? (rs->len - rs->pos) : 0);
+        for (int c = 0; c < 4; ++c) {
+            for (uint32_t k = 0; k < keep; ++k) {
+                rs->hist[c][k] = rs->hist[c][rs->pos + k];
+            }
         }
+        rs->pos -= (rs->len - keep);
+        rs->len = keep;
     }
+    return done;
+}
 
-    chip->tm_timer++;
-    uint16_t eg_incstep = aymo_(eg_incstep_table)[chip->tm_timer & 3];
-    chip->eg_incstep = vi2u(vset1((int16_t)eg_incstep));
-
-    // Update timed envelope patterns
-    int16_t eg_shift = (int16_t)ffsll((long long)chip->eg_timer);
-    int16_t eg_add = ((eg_shift > 13) ? 0 : eg_shift);
-    chip->eg_add = vset1(eg_add);
 
-    // Update envelope timer and flip state
-    if (chip->eg_state || ((chip->eg_timer & AYMO_(EG_TIMER_MASK)) == 0)) {
-        chip->eg_timer = (((chip->eg_timer + 1) & AYMO_(EG_TIMER_MASK)) | AYMO_(EG_TIMER_HIBIT));
+// Initializes a linear resampler, for output rates below 32 times SAMPLE_RATE
+// Higher rates are clamped, as interpolation weights must fit 16 bits
+void aymo_(rs_lin_init)(struct aymo_(rs_lin)* rs, uint32_t rate_out)
+{
+    uint64_t rateratio = (((uint64_t)rate_out << AYMO_(RS_LIN_FRAC)) / AYMO_(SAMPLE_RATE));
+    rs->rateratio = (int32_t)((rateratio < INT16_MAX) ? rateratio : INT16_MAX);
+    rs->samplecnt = 0;
+    for (int c = 0; c < 4; ++c) {
+        rs->oldsamples[c] = 0;
+        rs->samples[c] = 0;
     }
-    chip->eg_state ^= 1;
-    chip->eg_statev = vset1((int16_t)chip->eg_state);
 }
 
 
-// Updates the register queue
+// Truncated division of weighted sums by the rate ratio, bit-exact with integer division
 AYMO_INLINE
-void aymo_(rq_update)(struct aymo_(chip)* chip)
-{
-    if (chip->rq_delay) {
-        if (--chip->rq_delay) {
-            return;
+aymoi32_t aymo_(rs_lin_div)(aymoi32_t num, aymoi32_t ratio, aymof32_t ratio_rcp)
+{
+    // Estimate the quotient of absolute values, then correct it by the remainder
+    aymoi32_t sgn = vvsrai(num, 31);
+    aymoi32_t mag = vvsub(vvxor(num, sgn), sgn);
+    aymoi32_t quo = vfcvtt(vfmul(vfcvt(mag), ratio_rcp));
+    aymoi32_t rem = vvsub(mag, vvmullo(quo, ratio));
+    quo = vvsub(quo, vvcmpgt(rem, vvsub(ratio, vvset1(1))));
+    quo = vvadd(quo, vvcmpgt(vvsetz(), rem));
+    return vvsub(vvxor(quo, sgn), sgn);
+}
+
+
+// Resamples interleaved 4-channel frames, returning the number of output frames
+// Output is bit-exact with OPL3_Generate4ChResampled() fed by the same input frames
+uint32_t aymo_(rs_lin_process)(struct aymo_(rs_lin)* rs, uint32_t count, const int16_t* x, int16_t* y)
+{
+    uint32_t done = 0;
+    int32_t ratio = rs->rateratio;
+    aymoi32_t ratio_v = vvset1(ratio);
+    aymof32_t ratio_rcp = vfset1(1.f / (float)ratio);
+
+    for (;;) {
+        // Schedule a block of output samples, consuming input frames as they are due
+        uint32_t n = 0;
+        while (n < AYMO_(RS_BLOCK_LENGTH)) {
+            while ((rs->samplecnt >= ratio) && count) {
+                for (int c = 0; c < 4; ++c) {
+                    rs->oldsamples[c] = rs->samples[c];
+                    rs->samples[c] = x[c];
+                }
+                x += 4;
+                count--;
+                rs->samplecnt -= ratio;
+            }
+            if (rs->samplecnt >= ratio) {
+                break;
+            }
+            for (int c = 0; c < 4; ++c) {
+                rs->xx[(n * 4) + c][0] = rs->oldsamples[c];
+                rs->xx[(n * 4) + c][1] = rs->samples[c];
+                rs->ww[(n * 4) + c][0] = (int16_t)(ratio - rs->samplecnt);
+                rs->ww[(n * 4) + c][1] = (int16_t)rs->samplecnt;
+            }
+            rs->samplecnt += (1 << AYMO_(RS_LIN_FRAC));
+            n++;
         }
-    }
-    if (chip->rq_head != chip->rq_tail) {
-        struct aymo_(reg_queue_item)* item = &chip->rq_buffer[chip->rq_head];
 
-        if (item->address & 0x8000U) {
-            chip->rq_delay = AYMO_(REG_QUEUE_LATENCY);
-            chip->rq_delay += (((uint32_t)(item->address & 0x7FFFU) << 16) | item->value);
+        // Interpolate the block
+        uint32_t total = (n * 4);
+        uint32_t i = 0;
+        for (; (i + AYMO_(SLOT_GROUP_LENGTH)) <= total; i += AYMO_(SLOT_GROUP_LENGTH)) {
+            const uint32_t half = (AYMO_(SLOT_GROUP_LENGTH) / 2);
+            aymoi32_t num_lo = vvmadd(vloadu(&rs->xx[i][0]), vloadu(&rs->ww[i][0]));
+            aymoi32_t num_hi = vvmadd(vloadu(&rs->xx[i + half][0]), vloadu(&rs->ww[i + half][0]));
+            aymoi32_t quo_lo = aymo_(rs_lin_div)(num_lo, ratio_v, ratio_rcp);
+            aymoi32_t quo_hi = aymo_(rs_lin_div)(num_hi, ratio_v, ratio_rcp);
+            vstoreu(&y[i], vvpacks(quo_lo, quo_hi));
         }
-        else {
-            aymo_(write)(chip, item->address, item->value);
+        for (; i < total; ++i) {
+            int32_t num = ((rs->xx[i][0] * rs->ww[i][0]) + (rs->xx[i][1] * rs->ww[i][1]));
+            y[i] = (int16_t)(num / ratio);
         }
+        y += total;
+        done += n;
 
-        if (++chip->rq_head >= AYMO_(REG_QUEUE_LENGTH)) {
-            chip->rq_head = 0;
+        if (n < AYMO_(RS_BLOCK_LENGTH)) {
+            break;
         }
     }
+    return done;
 }
 
 
-// Exceutes a single processing tick
-void aymo_(tick)(struct aymo_(chip)* chip)
+// Generates a block of samples once, feeding all the output taps at their own rates
+// Each tap output must have room for the output of its resampler, for count input frames
+void aymo_(generate_i16x4_taps)(struct aymo_(chip)* chip, uint32_t count, struct aymo_(rs_tap)* taps, uint32_t tap_count)
 {
-    int sgi;
-    int cgi;
-
-    // Clear output accumulators
-    aymo_(og_clear)(chip);
-
-    // Process slot group 0
-    sgi = 0;
-    cgi = aymo_(sgi_to_cgi)(sgi);
-    aymo_(sg_update)(chip, &chip->cg[cgi], &chip->sg[sgi]);
-    aymo_(ng_update)(chip, (36 - 3));  // slot 16 --> slot 13
-    aymo_(rm_update_sg0)(chip);
-
-    // Process slot group 1
-    sgi = 1;
-    cgi = aymo_(sgi_to_cgi)(sgi);
-    aymo_(sg_update)(chip, &chip->cg[cgi], &chip->sg[sgi]);
-    aymo_(ng_update)(chip, 3);  // slot 13 --> slot 16
-    aymo_(rm_update_sg1)(chip);
-
-    // Process slot group 2
-    sgi = 2;
-    cgi = aymo_(sgi_to_cgi)(sgi);
-    aymo_(sg_update)(chip, &chip->cg[cgi], &chip->sg[sgi]);
-
-    // Process slot group 3
-    sgi = 3;
-    cgi = aymo_(sgi_to_cgi)(sgi);
-    aymo_(sg_update)(chip, &chip->cg[cgi], &chip->sg[sgi]);
-
-    // Update outputs
-    aymo_(og_update)(chip);
+    AYMO_ALIGN_V16 int16_t x[AYMO_(RS_BLOCK_LENGTH) * 4];
 
-    // Update timers
-    aymo_(tm_update)(chip);
+    while (count) {
+        uint32_t n = ((count < AYMO_(RS_BLOCK_LENGTH)) ? count : AYMO_(RS_BLOCK_LENGTH));
+        aymo_(generate_i16x4)(chip, n, x);
 
-    // Dequeue registers
-    aymo_(rq_update)(chip);
+        for (uint32_t t = 0; t < tap_count; ++t) {
+            struct aymo_(rs_tap)* tap = &taps[t];
+            uint32_t done;
+            if (tap->poly) {
+                done = aymo_(rs_poly_process)(tap->poly, n, x, tap->y);
+            }
+            else if (tap->lin) {
+                done = aymo_(rs_lin_process)(tap->lin, n, x, tap->y);
+            }
+            else {
+                for (uint32_t i = 0; i < (n * 4); ++i) {
+                    tap->y[i] = x[i];
+                }
+                done = n;
+            }
+            tap->y += (done * 4);
+            tap->count += done;
+        }
+        count -= n;
+    }
 }
 
 
@@ -988,6 +2316,7 @@ void aymo_(chip_pg_update_nts)(struct aymo_(chip)* chip)
 
         cg->eg_ksv = vinsertn(cg->eg_ksv, eg_ksv, sgo);
         sg->eg_ks  = vinsertn(sg->eg_ks,  ks,     sgo);
+        aymo_(eg_wake)(chip, sgi);
     }
 }
 
@@ -1013,8 +2342,9 @@ void aymo_(pg_update_fnum)(
     struct aymo_(reg_20h)* reg_20h0 = &(chip->slot_regs[slot0].reg_20h);
     int16_t ks0 = (eg_ksv >> ((reg_20h0->ksr ^ 1) << 1));
     sg0->eg_ks = vinsertn(sg0->eg_ks, ks0, sgo);
+    aymo_(eg_wake)(chip, sgi0);
     aymo_(eg_update_ksl)(chip, word0);
-    aymo_(pg_update_deltafreq)(chip, cg, sg0);
+    chip->pg_deltafreq_dirty |= (1u << (unsigned)sgi0);
 
     int word1 = aymo_(ch2x_to_word)[ch2x][1];
     int sgi1 = (word1 / AYMO_(SLOT_GROUP_LENGTH));
@@ -1023,8 +2353,9 @@ void aymo_(pg_update_fnum)(
     struct aymo_(reg_20h)* reg_20h1 = &(chip->slot_regs[slot1].reg_20h);
     int16_t ks1 = (eg_ksv >> ((reg_20h1->ksr ^ 1) << 1));
     sg1->eg_ks = vinsertn(sg1->eg_ks, ks1, sgo);
+    aymo_(eg_wake)(chip, sgi1);
     aymo_(eg_update_ksl)(chip, word1);
-    aymo_(pg_update_deltafreq)(chip, cg, sg1);
+    chip->pg_deltafreq_dirty |= (1u << (unsigned)sgi1);
 }
 
 
@@ -1055,6 +2386,7 @@ void aymo_(eg_key_on)(struct aymo_(chip)* chip, int word, int16_t mode)
     int16_t eg_key = vextractn(sg->eg_key, sgo);
     eg_key |= mode;
     sg->eg_key = vinsertn(sg->eg_key, eg_key, sgo);
+    aymo_(eg_wake)(chip, sgi);
 }
 
 
@@ -1067,6 +2399,7 @@ void aymo_(eg_key_off)(struct aymo_(chip)* chip, int word, int16_t mode)
     int16_t eg_key = vextractn(sg->eg_key, sgo);
     eg_key &= ~mode;
     sg->eg_key = vinsertn(sg->eg_key, eg_key, sgo);
+    aymo_(eg_wake)(chip, sgi);
 }
 
 
@@ -1140,22 +2473,91 @@ void aymo_(ch2x_key_off)(struct aymo_(chip)* chip, int ch2x)
 }
 
 
+// Updates the channel output gates of a slot group, masked by host-side mute/solo
+AYMO_INLINE
+void aymo_(og_update_ch_gates)(struct aymo_(chip)* chip, int sgi)
+{
+    struct aymo_(slot_group)* sg = &chip->sg[sgi];
+    const struct aymo_(slot_group_cold)* sgc = &chip->sg_cold[sgi];
+    const struct aymo_(ch2x_group)* cg = &chip->cg[aymo_(sgi_to_cgi)(sgi)];
+    aymoi16_t og_out_gate = vand(sgc->og_out_gate, cg->og_ch_play);
+    sg->og_out_ch_gate_a = vand(og_out_gate, cg->og_ch_gate_a);
+    sg->og_out_ch_gate_b = vand(og_out_gate, cg->og_ch_gate_b);
+    sg->og_out_ch_gate_c = vand(og_out_gate, cg->og_ch_gate_c);
+    sg->og_out_ch_gate_d = vand(og_out_gate, cg->og_ch_gate_d);
+}
+
+
+// Returns the mask of slots with active feedback
+AYMO_INLINE
+aymoi16_t aymo_(wg_fb_gate)(const struct aymo_(slot_group)* sg)
+{
+    return vandnot(vcmpz(sg->wg_fb_mulhi), sg->wg_fbmod_gate);
+}
+
+
+// Updates the mask of slot groups whose wave generators can be skipped
+// A slot is needed if its channel plays, if it has feedback, or if it modulates a needed slot
+AYMO_STATIC
+void aymo_(wg_update_skip)(struct aymo_(chip)* chip)
+{
+    uint32_t wg_skip_prev = chip->wg_skip;
+    chip->wg_skip = 0;
+
+    if (chip->og_mute_mask || chip->og_solo_mask) {
+        // Walk the modulation chain backwards, from consumers to modulators
+        aymoi16_t consumed = vsetz();
+        for (int i = (AYMO_(SLOT_GROUP_NUM) - 1); i >= 0; --i) {
+            int sgi = aymo_(wg_order)[i];
+            const struct aymo_(slot_group)* sg = &chip->sg[sgi];
+            const struct aymo_(ch2x_group)* cg = &chip->cg[aymo_(sgi_to_cgi)(sgi)];
+            aymoi16_t needed = vor(vor(cg->og_ch_play, consumed), aymo_(wg_fb_gate)(sg));
+            if (sgi < 2) {
+                needed = vsetf();  // rhythm
+            }
+            else if (vtestf(vcmpz(needed))) {
+                chip->wg_skip |= (1u << (unsigned)sgi);
+            }
+            consumed = vand(needed, sg->wg_prmod_gate);
+        }
+    }
+
+    // Recompute the last outputs from the first resumed slot group along the chain
+    // Slots with feedback never skip, so their history is kept as is
+    uint32_t resumed = (wg_skip_prev & ~chip->wg_skip);
+    if (resumed) {
+        int refresh = 0;
+        aymoi16_t wg_mod = vsetz();
+        for (int i = 0; i < AYMO_(SLOT_GROUP_NUM); ++i) {
+            int sgi = aymo_(wg_order)[i];
+            struct aymo_(slot_group)* sg = &chip->sg[sgi];
+            refresh |= (int)((resumed >> (unsigned)sgi) & 1u);
+            if (refresh) {
+                aymoi16_t phase = vadd(sg->pg_phase_out, vand(wg_mod, sg->wg_prmod_gate));
+                aymoi16_t wave_out = aymo_(wg_compute)(sg, phase);
+                wave_out = vblendv(wave_out, sg->wg_out, aymo_(wg_fb_gate)(sg));
+                sg->wg_out = wave_out;
+                sg->og_prout = wave_out;
+            }
+            wg_mod = sg->wg_out;
+        }
+    }
+}
+
+
 AYMO_STATIC
 void aymo_(cm_rewire_slot)(struct aymo_(chip)* chip, int word, const struct aymo_(conn)* conn)
 {
     int sgi = (word / AYMO_(SLOT_GROUP_LENGTH));
     int sgo = (word % AYMO_(SLOT_GROUP_LENGTH));
     struct aymo_(slot_group)* sg = &chip->sg[sgi];
+    struct aymo_(slot_group_cold)* sgc = &chip->sg_cold[sgi];
     sg->wg_fbmod_gate = vinsertn(sg->wg_fbmod_gate, conn->wg_fbmod_gate, sgo);
     sg->wg_prmod_gate = vinsertn(sg->wg_prmod_gate, conn->wg_prmod_gate, sgo);
-    sg->og_out_gate   = vinsertn(sg->og_out_gate,   conn->og_out_gate,   sgo);
+    sgc->og_out_gate = vinsertn(sgc->og_out_gate, conn->og_out_gate, sgo);
 
-    int cgi = aymo_(sgi_to_cgi)(sgi);
-    struct aymo_(ch2x_group)* cg = &chip->cg[cgi];
-    sg->og_out_ch_gate_a = vand(sg->og_out_gate, cg->og_ch_gate_a);
-    sg->og_out_ch_gate_b = vand(sg->og_out_gate, cg->og_ch_gate_b);
-    sg->og_out_ch_gate_c = vand(sg->og_out_gate, cg->og_ch_gate_c);
-    sg->og_out_ch_gate_d = vand(sg->og_out_gate, cg->og_ch_gate_d);
+    aymo_(og_update_ch_gates)(chip, sgi);
+    aymo_(wg_update_skip)(chip);
 }
 
 
@@ -1252,6 +2654,10 @@ void aymo_(cm_rewire_rhythm)(struct aymo_(chip)* chip, const struct aymo_(reg_BD
             aymo_(cm_rewire_slot)(chip, aymo_(ch2x_to_word)[8][0], &ch8_conn[0]);
             aymo_(cm_rewire_slot)(chip, aymo_(ch2x_to_word)[8][1], &ch8_conn[1]);
 
+            // Double rhythm slot outputs
+            chip->sg[0].og_ryt_gate = chip->og_ryt_gate;
+            chip->sg[1].og_ryt_gate = chip->og_ryt_gate;
+
             force_update = 1;
         }
     }
@@ -1273,6 +2679,9 @@ void aymo_(cm_rewire_rhythm)(struct aymo_(chip)* chip, const struct aymo_(reg_BD
             aymo_(cm_rewire_slot)(chip, aymo_(ch2x_to_word)[8][0], &ch8_conn[0]);
             aymo_(cm_rewire_slot)(chip, aymo_(ch2x_to_word)[8][1], &ch8_conn[1]);
 
+            chip->sg[0].og_ryt_gate = vsetz();
+            chip->sg[1].og_ryt_gate = vsetz();
+
             reg_BDh = &reg_BDh_zero;  // force all keys off
             force_update = 1;
         }
@@ -1383,6 +2792,7 @@ void aymo_(write_20h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
     int cgi = aymo_(sgi_to_cgi)(sgi);
     struct aymo_(ch2x_group)* cg = &(chip->cg[cgi]);
     struct aymo_(slot_group)* sg = &(chip->sg[sgi]);
+    struct aymo_(slot_group_cold)* sgc = &(chip->sg_cold[sgi]);
     struct aymo_(reg_20h)* reg_20h = &(chip->slot_regs[slot].reg_20h);
     struct aymo_(reg_20h) reg_20h_prev = *reg_20h;
     *(uint8_t*)(void*)reg_20h = value;
@@ -1390,7 +2800,7 @@ void aymo_(write_20h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 
     if (reg_20h->mult != reg_20h_prev.mult) {
         int16_t pg_mult_x2 = aymo_(pg_mult_x2_table)[reg_20h->mult];
-        sg->pg_mult_x2 = vinsertn(sg->pg_mult_x2, pg_mult_x2, sgo);
+        sgc->pg_mult_x2 = vinsertn(sgc->pg_mult_x2, pg_mult_x2, sgo);
         update_deltafreq = 1;  // force
     }
 
@@ -1398,6 +2808,7 @@ void aymo_(write_20h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
         int16_t eg_ksv = vextractn(cg->eg_ksv, sgo);
         int16_t eg_ks = (eg_ksv >> ((reg_20h->ksr ^ 1) << 1));
         sg->eg_ks = vinsertn(sg->eg_ks, eg_ks, sgo);
+        aymo_(eg_wake)(chip, sgi);
     }
 
     if (reg_20h->egt != reg_20h_prev.egt) {
@@ -1405,33 +2816,30 @@ void aymo_(write_20h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
         struct aymo_(eg_adsr)* eg_adsr = (struct aymo_(eg_adsr)*)(void*)&eg_adsr_word;
         eg_adsr->sr = (reg_20h->egt ? 0 : chip->slot_regs[slot].reg_80h.rr);
         sg->eg_adsr = vinsertn(sg->eg_adsr, eg_adsr_word, sgo);
+        aymo_(eg_wake)(chip, sgi);
     }
 
     if (reg_20h->vib != reg_20h_prev.vib) {
         int16_t pg_vib = (reg_20h->vib ? -1 : 0);
-        sg->pg_vib = vinsertn(sg->pg_vib, pg_vib, sgo);
+        sgc->pg_vib = vinsertn(sgc->pg_vib, pg_vib, sgo);
+        if (vtestf(vcmpz(sgc->pg_vib))) {
+            chip->pg_vib_mask &= ~(1u << (unsigned)sgi);
+        }
+        else {
+            chip->pg_vib_mask |= (1u << (unsigned)sgi);
+        }
         update_deltafreq = 1;  // force
     }
 
     if (reg_20h->am != reg_20h_prev.am) {
         int16_t eg_am = (reg_20h->am ? -1 : 0);
-        sg->eg_am = vinsertn(sg->eg_am, eg_am, sgo);
+        sgc->eg_am = vinsertn(sgc->eg_am, eg_am, sgo);
 
-        uint16_t eg_tremolopos = chip->eg_tremolopos;
-        if (eg_tremolopos >= 105) {
-            eg_tremolopos = (210 - eg_tremolopos);
-        }
-        aymoi16_t eg_tremolo = vset1((int16_t)(eg_tremolopos >> chip->eg_tremoloshift));
-        sg->eg_tremolo_am = vand(eg_tremolo, sg->eg_am);
+        sg->eg_tremolo_am = vand(chip->eg_tremolo, sgc->eg_am);
     }
 
     if (update_deltafreq) {
-        for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
-            int cgi = aymo_(sgi_to_cgi)(sgi);
-            struct aymo_(ch2x_group)* cg = &chip->cg[cgi];
-            struct aymo_(slot_group)* sg = &chip->sg[sgi];
-            aymo_(pg_update_deltafreq)(chip, cg, sg);
-        }
+        chip->pg_deltafreq_dirty |= (1u << (unsigned)sgi);
     }
 }
 
@@ -1451,10 +2859,12 @@ void aymo_(write_40h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
     if (reg_40h->tl != reg_40h_prev.tl) {
         int16_t eg_tl_x4 = ((int16_t)reg_40h->tl << 2);
         sg->eg_tl_x4 = vinsertn(sg->eg_tl_x4, eg_tl_x4, sgo);
+        aymo_(eg_wake)(chip, sgi);  // recheck silence
     }
 
     if (reg_40h->ksl != reg_40h_prev.ksl) {
         aymo_(eg_update_ksl)(chip, word);
+        aymo_(eg_wake)(chip, sgi);  // recheck silence
     }
 }
 
@@ -1477,6 +2887,7 @@ void aymo_(write_60h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
         eg_adsr->dr = reg_60h->dr;
         eg_adsr->ar = reg_60h->ar;
         sg->eg_adsr = vinsertn(sg->eg_adsr, eg_adsr_word, sgo);
+        aymo_(eg_wake)(chip, sgi);
     }
 }
 
@@ -1499,6 +2910,7 @@ void aymo_(write_80h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
         eg_adsr->sr = (chip->slot_regs[slot].reg_20h.egt ? 0 : reg_80h->rr);
         eg_adsr->rr = reg_80h->rr;
         sg->eg_adsr = vinsertn(sg->eg_adsr, eg_adsr_word, sgo);
+        aymo_(eg_wake)(chip, sgi);
         int16_t eg_sl = (int16_t)reg_80h->sl;
         if (eg_sl == 0x0F) {
             eg_sl = 0x1F;
@@ -1581,6 +2993,12 @@ void aymo_(write_B0h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 
         chip->eg_tremoloshift = (((reg_BDh->dam ^ 1) << 1) + 2);
         chip->eg_vibshift = (reg_BDh->dvb ^ 1);
+        if (reg_BDh->dam != reg_BDh_prev.dam) {
+            chip->eg_tremolo_refresh = 1;  // applied by the next timer update
+        }
+        if (reg_BDh->dvb != reg_BDh_prev.dvb) {
+            aymo_(pg_update_vib)(chip);
+        }
         aymo_(cm_rewire_rhythm)(chip, &reg_BDh_prev);
     }
     else {
@@ -1626,29 +3044,24 @@ void aymo_(write_C0h)(struct aymo_(chip)* chip, uint16_t address, uint8_t value)
 
     if (reg_C0h->cha != reg_C0h_prev.cha) {
         cg->og_ch_gate_a = vinsertn(cg->og_ch_gate_a, (reg_C0h->cha ? -1 : 0), sgo);
-        sg0->og_out_ch_gate_a = vand(sg0->og_out_gate, cg->og_ch_gate_a);
-        sg1->og_out_ch_gate_a = vand(sg1->og_out_gate, cg->og_ch_gate_a);
     }
     if (reg_C0h->chb != reg_C0h_prev.chb) {
         cg->og_ch_gate_b = vinsertn(cg->og_ch_gate_b, (reg_C0h->chb ? -1 : 0), sgo);
-        sg0->og_out_ch_gate_b = vand(sg0->og_out_gate, cg->og_ch_gate_b);
-        sg1->og_out_ch_gate_b = vand(sg1->og_out_gate, cg->og_ch_gate_b);
     }
     if (reg_C0h->chc != reg_C0h_prev.chc) {
         cg->og_ch_gate_c = vinsertn(cg->og_ch_gate_c, (reg_C0h->chc ? -1 : 0), sgo);
-        sg0->og_out_ch_gate_c = vand(sg0->og_out_gate, cg->og_ch_gate_c);
-        sg1->og_out_ch_gate_c = vand(sg1->og_out_gate, cg->og_ch_gate_c);
     }
     if (reg_C0h->chd != reg_C0h_prev.chd) {
         cg->og_ch_gate_d = vinsertn(cg->og_ch_gate_d, (reg_C0h->chd ? -1 : 0), sgo);
-        sg0->og_out_ch_gate_d = vand(sg0->og_out_gate, cg->og_ch_gate_d);
-        sg1->og_out_ch_gate_d = vand(sg1->og_out_gate, cg->og_ch_gate_d);
     }
+    aymo_(og_update_ch_gates)(chip, sgi0);
+    aymo_(og_update_ch_gates)(chip, sgi1);
 
     if (reg_C0h->fb != reg_C0h_prev.fb) {
         int16_t fb_mulhi = (reg_C0h->fb ? (0x0040 << reg_C0h->fb) : 0);
         sg0->wg_fb_mulhi = vinsertn(sg0->wg_fb_mulhi, fb_mulhi, sgo);
         sg1->wg_fb_mulhi = vinsertn(sg1->wg_fb_mulhi, fb_mulhi, sgo);
+        aymo_(wg_update_skip)(chip);
     }
 
     if (chip->chip_regs.reg_105h.stereo) {
@@ -1788,6 +3201,38 @@ size_t aymo_(size)(void)
 }
 
 
+// Sets host-side channel mute and solo masks, by Channel_2xOP index
+// Only the chip outputs are gated, without touching emulated registers
+// A non-zero solo mask plays only its channels; 4xOP channels need both halves
+void aymo_(og_set_mute_solo)(struct aymo_(chip)* chip, uint32_t mute_mask, uint32_t solo_mask)
+{
+    chip->og_mute_mask = mute_mask;
+    chip->og_solo_mask = solo_mask;
+    uint32_t play_mask = ((solo_mask ? solo_mask : 0xFFFFFFFFUL) & ~mute_mask);
+
+    for (int cgi = 0; cgi < (AYMO_(SLOT_GROUP_NUM) / 2); ++cgi) {
+        struct aymo_(ch2x_group)* cg = &chip->cg[cgi];
+        int sgi = aymo_(cgi_to_sgi)(cgi);
+        for (int sgo = 0; sgo < AYMO_(SLOT_GROUP_LENGTH); ++sgo) {
+            int ch2x = aymo_(word_to_ch2x)[(sgi * AYMO_(SLOT_GROUP_LENGTH)) + sgo];
+            int16_t play = (((play_mask >> ch2x) & 1) ? -1 : 0);
+            cg->og_ch_play = vinsertn(cg->og_ch_play, play, sgo);
+        }
+    }
+    for (int sgi = 0; sgi < AYMO_(SLOT_GROUP_NUM); ++sgi) {
+        aymo_(og_update_ch_gates)(chip, sgi);
+    }
+    aymo_(wg_update_skip)(chip);
+}
+
+
+// Sets the low-fidelity level, clamped to LOFI_MAX; 0 is bit-exact
+void aymo_(set_lofi)(struct aymo_(chip)* chip, uint8_t lofi)
+{
+    chip->process_lofi = ((lofi < AYMO_(LOFI_MAX)) ? lofi : AYMO_(LOFI_MAX));
+}
+
+
 // Initializes chip status
 void aymo_(init)(struct aymo_(chip)* chip)
 {
@@ -1802,7 +3247,7 @@ void aymo_(init)(struct aymo_(chip)* chip)
         sg->eg_gen = vset1(AYMO_(EG_GEN_RELEASE));
         sg->eg_gen_mullo = vset1(AYMO_(EG_GEN_MULLO_RELEASE));
         sg->pg_notreset = vset1(-1);
-        sg->pg_mult_x2 = vset1(aymo_(pg_mult_x2_table)[0]);
+        chip->sg_cold[sgi].pg_mult_x2 = vset1(aymo_(pg_mult_x2_table)[0]);
         sg->og_prout_ac = vsetm(aymo_(og_prout_ac)[sgi]);
         sg->og_prout_bd = vsetm(aymo_(og_prout_bd)[sgi]);
 
@@ -1822,6 +3267,7 @@ void aymo_(init)(struct aymo_(chip)* chip)
         struct aymo_(ch2x_group)* cg = &(chip->cg[cgi]);
         cg->og_ch_gate_a = vset1(-1);
         cg->og_ch_gate_b = vset1(-1);
+        cg->og_ch_play = vset1(-1);
     }
     for (int ch2x = 0; ch2x < AYMO_(CHANNEL_NUM_MAX); ++ch2x) {
         aymo_(cm_rewire_ch2x)(chip, ch2x);
@@ -1829,6 +3275,9 @@ void aymo_(init)(struct aymo_(chip)* chip)
 
     // Initialize chip
     chip->eg_statev = vset1(1);
+    chip->rm_hh_sd_gate = vsetm(1 << 9);
+    chip->rm_tc_gate = vsetm(1 << 10);
+    chip->og_ryt_gate = vsetm(((1 << 8) | (1 << 9) | (1 << 10)));
 
     chip->eg_timer = AYMO_(EG_TIMER_HIBIT);
 
@@ -219,6 +219,28 @@ struct aymo_(reg_queue_item) {
 #define AYMO_YMF262_X86_SSE41_EG_TIMER_HIBIT        (1ULL << 36)
 #define AYMO_YMF262_X86_SSE41_EG_TIMER_MASK         (AYMO_YMF262_X86_SSE41_EG_TIMER_HIBIT - 1ULL)
 
+#ifndef AYMO_YMF262_X86_SSE41_TM_BLOCK_LENGTH
+#define AYMO_YMF262_X86_SSE41_TM_BLOCK_LENGTH       64
+#endif
+#ifndef AYMO_YMF262_X86_SSE41_PG_RUN_LENGTH
+#define AYMO_YMF262_X86_SSE41_PG_RUN_LENGTH         16
+#endif
+#define AYMO_YMF262_X86_SSE41_LOFI_MAX              3
+
+#ifndef AYMO_YMF262_X86_SSE41_RS_BLOCK_LENGTH
+#define AYMO_YMF262_X86_SSE41_RS_BLOCK_LENGTH       256
+#endif
+#define AYMO_YMF262_X86_SSE41_RS_TAPS               32
+#define AYMO_YMF262_X86_SSE41_RS_PHASES             64
+#define AYMO_YMF262_X86_SSE41_RS_LIN_FRAC           10
+
+// Envelope timing schedule for a block of ticks
+struct aymo_(eg_sched) {
+    uint16_t eg_incstep[AYMO_(TM_BLOCK_LENGTH)];
+    int16_t eg_add[AYMO_(TM_BLOCK_LENGTH)];
+    int16_t eg_state[AYMO_(TM_BLOCK_LENGTH)];
+};
+
 
 #define AYMO_YMF262_X86_SSE41_EG_GEN_ATTACK         0
 #define AYMO_YMF262_X86_SSE41_EG_GEN_DECAY          1
@@ -244,10 +266,29 @@ struct aymo_(eg_adsr) {
 };
 
 
-// Slot SIMD group status
-// Processing order (kinda)
+// Slot SIMD group status, updated by every tick
+// Processing order
 AYMO_ALIGN_V16
 struct aymo_(slot_group) {
+    aymoi16_t eg_rout;
+    aymoi16_t eg_tl_x4;
+    aymoi16_t eg_ksl_sh;
+    aymoi16_t eg_tremolo_am;
+    aymoi16_t eg_gen;
+    aymoi16_t eg_sl;
+    aymoi16_t eg_key;           // bit 8 = drum, bit 0 = normal
+    aymoi16_t pg_notreset;
+    aymoi16_t eg_adsr;          // struct aymo_(eg_adsr)
+    aymoi16_t eg_gen_mullo;     // depends on reg_type for reg_sr
+    aymoi16_t eg_ks;
+    aymoi16_t eg_out;
+
+    aymoi16_t pg_phase_out;
+    aymoi16_t pg_deltafreq;       // bits 9-24 of the phase increment
+    aymoi16_t pg_deltafreq_frac;  // bits 0-8 of the phase increment
+    aymoi16_t pg_phase;           // bits 9-24 of the phase accumulator
+    aymoi16_t pg_phase_frac;      // bits 0-8 of the phase accumulator
+
     aymoi16_t wg_out;
     aymoi16_t wg_prout;
     aymoi16_t wg_fb_mulhi;
@@ -267,31 +308,7 @@ struct aymo_(slot_group) {
     aymoi16_t og_out_ch_gate_c;
     aymoi16_t og_out_ch_gate_b;
     aymoi16_t og_out_ch_gate_d;
-
-    aymoi16_t eg_rout;
-    aymoi16_t eg_tl_x4;
-    aymoi16_t eg_ksl_sh;
-    aymoi16_t eg_tremolo_am;
-    aymoi16_t eg_out;
-    aymoi16_t eg_gen;
-    aymoi16_t eg_sl;
-    aymoi16_t eg_key;           // bit 8 = drum, bit 0 = normal
-    aymoi16_t pg_notreset;
-    aymoi16_t eg_adsr;          // struct aymo_(eg_adsr)
-    aymoi16_t eg_gen_mullo;     // depends on reg_type for reg_sr
-    aymoi16_t eg_ks;
-
-    aymoi16_t pg_vib;
-    aymoi16_t pg_mult_x2;
-    aymoi32_t pg_deltafreq_lo;
-    aymoi32_t pg_deltafreq_hi;
-    aymoi32_t pg_phase_lo;
-    aymoi32_t pg_phase_hi;
-    aymoi16_t pg_phase_out;
-
-    // Updated only by writing registers
-    aymoi16_t eg_am;
-    aymoi16_t og_out_gate;
+    aymoi16_t og_ryt_gate;
 
 #ifdef AYMO_DEBUG
     // Variables for debug
@@ -317,26 +334,101 @@ struct aymo_(ch2x_group) {
     aymoi16_t og_ch_gate_b;
     aymoi16_t og_ch_gate_c;
     aymoi16_t og_ch_gate_d;
+    aymoi16_t og_ch_play;  // host-side mute/solo
 
 #ifdef AYMO_DEBUG
     // Variables for debug
 #endif  // AYMO_dEBUG
 };
 
+// Slot SIMD group status, updated only by writing registers
+AYMO_ALIGN_V16
+struct aymo_(slot_group_cold) {
+    aymoi16_t pg_vib;
+    aymoi16_t pg_mult_x2;
+    aymoi16_t eg_am;
+    aymoi16_t og_out_gate;
+};
+
+// Phase generator outputs precomputed for a run of ticks
+struct aymo_(pg_run) {
+    aymoi16_t pg_phase_out[AYMO_(SLOT_GROUP_NUM)][AYMO_(PG_RUN_LENGTH)];
+    aymoi16_t pg_deltafreq[AYMO_(SLOT_GROUP_NUM)];
+    aymoi16_t pg_deltafreq_frac[AYMO_(SLOT_GROUP_NUM)];
+    uint32_t pg_deltafreq_serial[AYMO_(SLOT_GROUP_NUM)];
+    uint8_t pos[AYMO_(SLOT_GROUP_NUM)];
+    uint8_t len[AYMO_(SLOT_GROUP_NUM)];
+};
+
+// Per-channel outputs buffered for a block of ticks, to be stored as planar stems
+struct aymo_(og_ch2x_block) {
+    aymoi16_t og_out[AYMO_(SLOT_GROUP_NUM) / 2][AYMO_(SLOT_GROUP_LENGTH)];  // ticks by channel group lane
+    uint32_t offset;
+    uint8_t pos;
+};
+
+// Per-channel level meters, accumulated over a rendered block
+struct aymo_(og_meters) {
+    uint64_t energy[AYMO_(CHANNEL_NUM)];  // sum of squares
+    uint32_t count;  // samples
+    uint16_t peak[AYMO_(CHANNEL_NUM)];  // absolute
+};
+
+// Destinations of the block renderer, each optional (NULL)
+struct aymo_(og_sink) {
+    int16_t* y;  // 4 channels interleaved, saturated
+    int32_t* mix_i32;  // 4 channels interleaved, accumulated
+    float* mix_f32;  // 4 channels interleaved, accumulated
+    int16_t* ych;  // Channel_2xOP stems, planar
+    struct aymo_(og_meters)* meters;
+    int32_t mix_gain;  // 16.16 fixed point
+};
+
+// Polyphase FIR resampler status, from SAMPLE_RATE to an output rate
+AYMO_ALIGN_V16
+struct aymo_(rs_poly) {
+    int16_t hist[4][AYMO_(RS_BLOCK_LENGTH) + AYMO_(RS_TAPS)];  // planar input history
+    uint32_t rate_out;
+    uint32_t frac;  // position within an input sample, in 1 / rate_out units
+    uint32_t pos;  // position in the history
+    uint32_t len;  // history length
+};
+
+// Linear resampler status, matching OPL3_Generate4ChResampled() of Nuked OPL3
+AYMO_ALIGN_V16
+struct aymo_(rs_lin) {
+    int16_t xx[AYMO_(RS_BLOCK_LENGTH) * 4][2];  // old and new input samples, per output sample
+    int16_t ww[AYMO_(RS_BLOCK_LENGTH) * 4][2];  // old and new weights, per output sample
+    int32_t rateratio;
+    int32_t samplecnt;
+    int16_t oldsamples[4];
+    int16_t samples[4];
+};
+
+// Output tap at its own sample rate, fed by the shared chip rate block
+struct aymo_(rs_tap) {
+    struct aymo_(rs_poly)* poly;  // polyphase resampler, or NULL
+    struct aymo_(rs_lin)* lin;  // linear resampler, or NULL for SAMPLE_RATE
+    int16_t* y;  // 4 channels interleaved, advanced while written
+    uint32_t count;  // output frames written
+};
+
 // Chip SIMD and scalar status data
-// Processing order (kinda), size/alignment order
+// Hot data first, then cold data, each in size/alignment order
 AYMO_ALIGN_V16
 struct aymo_(chip) {
-    // Vector data
+    // Hot data, touched by every tick, in processing order
     struct aymo_(slot_group) sg[AYMO_(SLOT_GROUP_NUM)];
-    struct aymo_(ch2x_group) cg[AYMO_(SLOT_GROUP_NUM) / 2];
 
     aymoi16_t wg_mod;
     aymoi16_t eg_statev;
     aymoi16_t eg_add;
     aymou16_t eg_incstep;
-    aymoi16_t pg_vib_mulhi;
-    aymoi16_t pg_vib_neg;
+    aymoi16_t rm_hh_phase;
+    aymoi16_t rm_tc_phase;
+    aymoi16_t rm_hh_sd_gate;
+    aymoi16_t rm_tc_gate;
+    aymoi16_t og_ryt_gate;
 
     aymoi16_t og_acc_a;
     aymoi16_t og_acc_c;
@@ -353,9 +445,12 @@ struct aymo_(chip) {
     int32_t og_sum_c;
     int32_t og_sum_b;
     int32_t og_sum_d;
-    uint32_t og_ch2x_pairing;
-    uint32_t og_ch2x_drum;
     uint32_t ng_noise;
+    uint32_t eg_idle;  // slot group bit mask
+    uint32_t pg_deltafreq_dirty;  // slot group bit mask
+    uint32_t pg_deltafreq_serial;
+    uint32_t wg_skip;  // slot group bit mask
+    uint32_t wg_silent;  // slot group bit mask, of steady groups below the audible level
 
     // 16-bit data
     int16_t og_out_a;
@@ -369,20 +464,32 @@ struct aymo_(chip) {
 
     // 8-bit data
     uint8_t eg_state;
-    uint8_t rm_hh_bit2;
-    uint8_t rm_hh_bit3;
-    uint8_t rm_hh_bit7;
-    uint8_t rm_hh_bit8;
-    uint8_t rm_tc_bit3;
-    uint8_t rm_tc_bit5;
     uint8_t eg_tremolopos;
     uint8_t eg_tremoloshift;
     uint8_t eg_vibshift;
     uint8_t pg_vibpos;
     uint8_t process_all_slots;
-    uint8_t pad32_[2];
+    uint8_t eg_tremolo_refresh;
+    uint8_t process_lofi;  // wave generators run every (1 << process_lofi) ticks; see set_lofi()
+    uint8_t pad32_[4];
+
+    struct aymo_(chip_regs) chip_regs;  // rhythm mode is checked by every tick
+
+    // Cold data, touched only by writing registers and LFO steps
+    struct aymo_(slot_group_cold) sg_cold[AYMO_(SLOT_GROUP_NUM)];
+    struct aymo_(ch2x_group) cg[AYMO_(SLOT_GROUP_NUM) / 2];
+
+    aymoi16_t eg_tremolo;
+    aymoi16_t pg_vib_mulhi;
+    aymoi16_t pg_vib_neg;
+
+    // 32-bit data
+    uint32_t og_ch2x_pairing;
+    uint32_t og_ch2x_drum;
+    uint32_t pg_vib_mask;  // slot group bit mask
+    uint32_t og_mute_mask;  // Channel_2xOP bit mask
+    uint32_t og_solo_mask;  // Channel_2xOP bit mask
 
-    struct aymo_(chip_regs) chip_regs;
     struct aymo_(slot_regs) slot_regs[AYMO_(SLOT_NUM_MAX)];
     struct aymo_(chan_regs) ch2x_regs[AYMO_(CHANNEL_NUM_MAX)];
 
@@ -395,9 +502,26 @@ struct aymo_(chip) {
 
 
 void aymo_(tick)(struct aymo_(chip)* chip);
+void aymo_(generate_i16x4)(struct aymo_(chip)* chip, uint32_t count, int16_t* y);
+void aymo_(generate_i16x4_ch2x)(struct aymo_(chip)* chip, uint32_t count, int16_t* y, int16_t* ych);
+void aymo_(generate_i16x4_meters)(struct aymo_(chip)* chip, uint32_t count, int16_t* y, struct aymo_(og_meters)* meters);
+void aymo_(generate_mix_i32x4)(struct aymo_(chip)* chip, uint32_t count, int32_t* y, int32_t gain);
+void aymo_(generate_mix_f32x4)(struct aymo_(chip)* chip, uint32_t count, float* y, int32_t gain);
+void aymo_(convert_i16x4_i16x2)(uint32_t count, const int16_t* x, int16_t* y);
+void aymo_(convert_i16_i24)(uint32_t count, const int16_t* x, uint8_t* y);
+void aymo_(convert_i16_i32)(uint32_t count, const int16_t* x, int32_t* y);
+void aymo_(convert_i16_f32)(uint32_t count, const int16_t* x, float* y);
+void aymo_(rs_poly_init)(struct aymo_(rs_poly)* rs, uint32_t rate_out);
+uint32_t aymo_(rs_poly_process)(struct aymo_(rs_poly)* rs, uint32_t count, const int16_t* x, int16_t* y);
+void aymo_(rs_lin_init)(struct aymo_(rs_lin)* rs, uint32_t rate_out);
+uint32_t aymo_(rs_lin_process)(struct aymo_(rs_lin)* rs, uint32_t count, const int16_t* x, int16_t* y);
+void aymo_(generate_i16x4_taps)(struct aymo_(chip)* chip, uint32_t count, struct aymo_(rs_tap)* taps, uint32_t tap_count);
 void aymo_(write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 int aymo_(enqueue_write)(struct aymo_(chip)* chip, uint16_t address, uint8_t value);
 int aymo_(enqueue_delay)(struct aymo_(chip)* chip, uint32_t ticks);
+void aymo_(ng_skip)(struct aymo_(chip)* chip, uint64_t steps);
+void aymo_(og_set_mute_solo)(struct aymo_(chip)* chip, uint32_t mute_mask, uint32_t solo_mask);
+void aymo_(set_lofi)(struct aymo_(chip)* chip, uint8_t lofi);
 size_t aymo_(size)(void);
 void aymo_(init)(struct aymo_(chip)* chip);
 
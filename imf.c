@@ -166,6 +166,98 @@ const struct imf_cmd imf_opl_tick(
 }
 
 
+// Pre-scans the loaded events for duration, statistics, and a coarse seek index
+// Blocks are classified branchless, and walked in order only across seek periods
+void imf_scan(
+    struct imf_scan_result* scan,
+    const struct imf_status* status,
+    uint32_t seek_period,
+    uint32_t* seek,
+    uint32_t seek_size
+)
+{
+    const struct imf_event* events;
+    const struct imf_event* block;
+    uint32_t costs[IMF_SCAN_BLOCK];
+    uint8_t writes[IMF_SCAN_BLOCK];
+    uint64_t tick = 0;
+    uint64_t boundary = 0;
+    uint32_t window_writes = 0;
+    uint32_t base;
+    uint32_t n;
+    uint32_t i;
+    uint32_t division;
+    assert(scan);
+    assert(status);
+    assert(seek_period);
+
+    scan->duration = 0;
+    scan->delay_sum = 0;
+    scan->write_count = 0;
+    scan->delay_count = 0;
+    scan->window_writes_max = 0;
+    scan->seek_period = seek_period;
+    scan->seek = seek;
+    scan->seek_size = (seek ? seek_size : 0);
+    scan->seek_length = 0;
+    events = status->events;
+    division = status->division;
+
+    for (base = 0; base < status->length; base += n) {
+        uint64_t block_delay = 0;
+        uint32_t block_cost = 0;
+        uint32_t block_writes = 0;
+        uint32_t block_delays = 0;
+        n = (status->length - base);
+        if (n > IMF_SCAN_BLOCK) {
+            n = IMF_SCAN_BLOCK;
+        }
+
+        block = &events[base];
+        for (i = 0; i < n; ++i) {
+            const struct imf_event* event = &block[i];
+            uint32_t delay = (((uint32_t)event->delay_hi << 8) | event->delay_lo);
+            writes[i] = (uint8_t)(event->address_lo != 0x05);  // not the virtual register
+            costs[i] = ((delay + (uint32_t)(delay == 0)) * division);
+            block_delays += (uint32_t)(delay > 0);
+            block_delay += delay;
+            block_cost += costs[i];
+            block_writes += writes[i];
+        }
+        scan->delay_sum += block_delay;
+        scan->write_count += block_writes;
+        scan->delay_count += block_delays;
+
+        if ((tick + block_cost) <= boundary) {
+            tick += block_cost;
+            window_writes += block_writes;
+        }
+        else {
+            for (i = 0; i < n; ++i) {
+                while (tick >= boundary) {
+                    if (scan->seek_length < scan->seek_size) {
+                        seek[scan->seek_length] = (base + i);
+                    }
+                    scan->seek_length++;
+                    if (scan->window_writes_max < window_writes) {
+                        scan->window_writes_max = window_writes;
+                    }
+                    window_writes = 0;
+                    boundary += seek_period;
+                }
+                tick += costs[i];
+                window_writes += writes[i];
+            }
+        }
+    }
+
+    if (scan->window_writes_max < window_writes) {
+        scan->window_writes_max = window_writes;
+    }
+    scan->duration = tick;
+}
+
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
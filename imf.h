@@ -8,6 +8,10 @@
 extern "C" {
 #endif
 
+#ifndef IMF_SCAN_BLOCK
+#define IMF_SCAN_BLOCK          128
+#endif
+
 #pragma pack(push, 1)
 
 
@@ -54,6 +58,19 @@ struct imf_status {
 };
 
 
+struct imf_scan_result {
+    uint64_t duration;  // OPL ticks until the end of stream, as played
+    uint64_t delay_sum;  // sum of the delay values, in IMF ticks
+    uint32_t write_count;
+    uint32_t delay_count;
+    uint32_t window_writes_max;  // most writes within a seek period
+    uint32_t seek_period;  // OPL ticks between seek index entries
+    uint32_t* seek;  // first event played at each seek period, or NULL
+    uint32_t seek_size;  // seek index capacity
+    uint32_t seek_length;  // seek index entries, even beyond capacity
+};
+
+
 struct imf_cmd {
     uint16_t address;
     uint8_t value;
@@ -87,6 +104,14 @@ const struct imf_cmd imf_opl_tick(
     struct imf_status* status
 );
 
+void imf_scan(
+    struct imf_scan_result* scan,
+    const struct imf_status* status,
+    uint32_t seek_period,
+    uint32_t* seek,
+    uint32_t seek_size
+);
+
 
 #pragma pack(pop)
 
@@ -36,11 +36,36 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <fcntl.h>
+    #include <io.h>
+    #define pipe_open(fds)              _pipe((fds), 65536, _O_BINARY)
+    #define pipe_write(fd, buf, size)   _write((fd), (buf), (unsigned)(size))
+    #define pipe_close(fd)              _close(fd)
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define pipe_open(fds)              pipe(fds)
+    #define pipe_write(fd, buf, size)   write((fd), (buf), (size))
+    #define pipe_close(fd)              close(fd)
+#endif
 
 
 #ifndef assert
@@ -56,7 +81,87 @@ along with AYMO. If not, see <https://www.gnu.org/licenses/>.
 #endif
 
 
+// Read-only file mapping, hinted for sequential access; empty if unavailable
+class mapped_file
+{
+public:
+    explicit mapped_file(const char* path)
+    {
+#ifdef _WIN32
+        file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            (FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN), NULL);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || !size.QuadPart) {
+            return;
+        }
+        mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping_) {
+            return;
+        }
+        data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (data_) {
+            size_ = (size_t)size.QuadPart;
+        }
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (!fstat(fd, &st) && (st.st_size > 0)) {
+            void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+                data_ = data;
+                size_ = (size_t)st.st_size;
+            }
+        }
+        close(fd);  // the mapping keeps its own reference
+#endif
+    }
+
+    ~mapped_file()
+    {
+#ifdef _WIN32
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#else
+        if (data_) {
+            munmap(const_cast<void*>(data_), size_);
+        }
+#endif
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    // Never NULL, so that loaders can keep asserting on their event pointers
+    const void* data() const { return (data_ ? data_ : &empty_); }
+    size_t size() const { return size_; }
+
+private:
+    const void* data_ = NULL;
+    size_t size_ = 0;
+    char empty_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+#endif
+};
+
+
 static struct aymo_(chip) aymo_chip;
+static struct aymo_(chip) aymo_chip2;
 static opl3_chip nuked_chip;
 
 
@@ -109,6 +214,7 @@ void compare_slots(const struct aymo_(chip)* aymo_chip, const opl3_chip* nuked_c
     int cgi = (sgi / 2);
 #endif
     const struct aymo_(slot_group)* sg = &aymo_chip->sg[sgi];
+    const struct aymo_(slot_group_cold)* sgc = &aymo_chip->sg_cold[sgi];
     const struct aymo_(ch2x_group)* cg = &aymo_chip->cg[cgi];
     const opl3_slot* slot = &nuked_chip->slot[slot_];
     (void)cg;
@@ -130,10 +236,10 @@ void compare_slots(const struct aymo_(chip)* aymo_chip, const opl3_chip* nuked_c
     assert(vextractn(sg->eg_rate, sgo) == slot->eg_rate);
     assert(vextractn(sg->eg_ksl, sgo) == slot->eg_ksl);
     assert(vextractn(sg->eg_tremolo_am, sgo) == *slot->trem);
-    assert((uint16_t)-vextractn(sg->pg_vib, sgo) == slot->reg_vib);
+    assert((uint16_t)-vextractn(sgc->pg_vib, sgo) == slot->reg_vib);
     //assert(vextractn(sg->eg_egt, sgo) == slot->reg_type);
     //assert(vextractn(sg->eg_ksr, sgo) == slot->reg_ksr);
-    assert((uint16_t)vextractn(sg->pg_mult_x2, sgo) == mt[slot->reg_mult]);
+    assert((uint16_t)vextractn(sgc->pg_mult_x2, sgo) == mt[slot->reg_mult]);
     assert((uint16_t)vextractn(sg->eg_tl_x4, sgo) == slot->reg_tl * 4U);
     assert((((uint16_t)vextractn(sg->eg_adsr, sgo) >> 12) & 15) == slot->reg_ar);
     assert((((uint16_t)vextractn(sg->eg_adsr, sgo) >>  8) & 15) == slot->reg_dr);
@@ -142,16 +248,9 @@ void compare_slots(const struct aymo_(chip)* aymo_chip, const opl3_chip* nuked_c
     //assert(vextractn(sg->wg_wf, sgo) == slot->reg_wf);
     assert((uint16_t)vextractn(sg->eg_key, sgo) == slot->key);
     assert((uint16_t)-vextractn(sg->pg_notreset, sgo) == !slot->pg_reset);
-    const int sgo_side[16] = { 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1 };
-    const int sgo_cell[16] = { 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7, 4, 5, 6, 7 };
-#if defined(AYMO_ARCH_IS_X86_SSE41)
-    uint32_t pg_phase = vvextractn(sgo_side[sgo] ? sg->pg_phase_hi : sg->pg_phase_lo), sgo_cell[sgo]);
-#elif defined(AYMO_ARCH_IS_X86_AVX2)
-    uint32_t pg_phase = vvextractn(sgo_side[sgo] ? sg->pg_phase_hi : sg->pg_phase_lo), sgo_cell[sgo]);
-#elif defined(AYMO_ARCH_IS_ARMV7_NEON)
-    uint32_t pg_phase = vvextractn(sgo_side[sgo] ? sg->pg_phase_hi : sg->pg_phase_lo), sgo_cell[sgo]);
-#endif
-    assert(pg_phase == slot->pg_phase);
+    uint32_t pg_phase = (((uint32_t)(uint16_t)vextractn(sg->pg_phase, sgo) << 9) |
+                         (uint32_t)(uint16_t)vextractn(sg->pg_phase_frac, sgo));
+    assert(pg_phase == (slot->pg_phase & 0x01FFFFFFUL));
     assert((uint16_t)vextractn(sg->pg_phase_out, sgo) == slot->pg_phase_out);
 #endif  // AYMO_DEBUG
 }
@@ -211,7 +310,7 @@ void compare_chips(const struct aymo_(chip)* aymo_chip, const opl3_chip* nuked_c
     //uint8_t rhy;
     assert(aymo_chip->pg_vibpos == nuked_chip->vibpos);
     assert(aymo_chip->eg_vibshift == nuked_chip->vibshift);
-    //assert((uint16_t)vextractn(aymo_chip->eg_tremolo, 0) == nuked_chip->tremolo);
+    assert((uint16_t)vextractn(aymo_chip->eg_tremolo, 0) == nuked_chip->tremolo);
     assert(aymo_chip->eg_tremolopos == nuked_chip->tremolopos);
     assert(aymo_chip->eg_tremoloshift == nuked_chip->tremoloshift);
     assert(aymo_chip->ng_noise == nuked_chip->noise);
@@ -219,12 +318,21 @@ void compare_chips(const struct aymo_(chip)* aymo_chip, const opl3_chip* nuked_c
     assert(aymo_chip->og_sum_b == nuked_chip->mixbuff[1]);
     assert(aymo_chip->og_sum_c == nuked_chip->mixbuff[2]);
     assert(aymo_chip->og_sum_d == nuked_chip->mixbuff[3]);
-    assert(aymo_chip->rm_hh_bit2 == nuked_chip->rm_hh_bit2);
-    assert(aymo_chip->rm_hh_bit3 == nuked_chip->rm_hh_bit3);
-    assert(aymo_chip->rm_hh_bit7 == nuked_chip->rm_hh_bit7);
-    assert(aymo_chip->rm_hh_bit8 == nuked_chip->rm_hh_bit8);
-    assert(aymo_chip->rm_tc_bit3 == nuked_chip->rm_tc_bit3);
-    assert(aymo_chip->rm_tc_bit5 == nuked_chip->rm_tc_bit5);
+    if (nuked_chip->rhy & 0x20) {
+#if (AYMO_(SLOT_GROUP_LENGTH) == 8)
+        const int rm_sgo = 1;
+#else
+        const int rm_sgo = 9;
+#endif
+        uint16_t rm_hh_phase = (uint16_t)vextractn(aymo_chip->rm_hh_phase, rm_sgo);
+        uint16_t rm_tc_phase = (uint16_t)vextractn(aymo_chip->rm_tc_phase, rm_sgo);
+        assert(((rm_hh_phase >> 2) & 1) == nuked_chip->rm_hh_bit2);
+        assert(((rm_hh_phase >> 3) & 1) == nuked_chip->rm_hh_bit3);
+        assert(((rm_hh_phase >> 7) & 1) == nuked_chip->rm_hh_bit7);
+        assert(((rm_hh_phase >> 8) & 1) == nuked_chip->rm_hh_bit8);
+        assert(((rm_tc_phase >> 3) & 1) == nuked_chip->rm_tc_bit3);
+        assert(((rm_tc_phase >> 5) & 1) == nuked_chip->rm_tc_bit5);
+    }
 
     for (int ch2x = 0; ch2x < 18; ++ch2x) {
         compare_ch2xs(aymo_chip, nuked_chip, ch2x);
@@ -237,6 +345,447 @@ void compare_chips(const struct aymo_(chip)* aymo_chip, const opl3_chip* nuked_c
 }
 
 
+void rs_lin_test(void)
+{
+    // Rates around the 16-bit weight limit, at 32 times SAMPLE_RATE
+    static const uint32_t rates[] = { 8000, 44100, 48000, 96000, 1590911, 1590912, 4194304 };
+    static int16_t aymo_in[256 * 4];
+    static int16_t aymo_out[((256 * 32) + 2) * 4];
+    static struct aymo_(rs_lin) rs;
+
+    for (uint32_t rate : rates) {
+        aymo_(init)(&aymo_chip);
+        OPL3_Reset(&nuked_chip, ((rate < 1590912) ? rate : 1590911));
+        aymo_(rs_lin_init)(&rs, rate);
+        assert(rs.rateratio == nuked_chip.rateratio);
+
+        // Decaying 4-channel tone with feedback, all registers set before rendering
+        // Nuked generates chip frames on demand, so later writes would land elsewhere
+        static const uint16_t regs[][2] = {
+            { 0x105, 0x01 },
+            { 0x020, 0x01 }, { 0x023, 0x02 }, { 0x040, 0x00 }, { 0x043, 0x00 },
+            { 0x060, 0xF3 }, { 0x063, 0xF2 }, { 0x080, 0x05 }, { 0x083, 0x05 },
+            { 0x0C0, 0xFE }, { 0x0A0, 0x6B }, { 0x0B0, 0x31 },
+            { 0x021, 0x03 }, { 0x024, 0x01 }, { 0x041, 0x00 }, { 0x044, 0x00 },
+            { 0x061, 0xF1 }, { 0x064, 0xF4 }, { 0x081, 0x05 }, { 0x084, 0x05 },
+            { 0x0C1, 0x3C }, { 0x0A1, 0x41 }, { 0x0B1, 0x36 }
+        };
+        for (const auto& reg : regs) {
+            OPL3_WriteReg(&nuked_chip, reg[0], (uint8_t)reg[1]);
+            aymo_(write)(&aymo_chip, reg[0], (uint8_t)reg[1]);
+        }
+
+        uint32_t mismatches = 0;
+        for (uint32_t block = 0; block < 64; ++block) {
+            aymo_(generate_i16x4)(&aymo_chip, 256, aymo_in);
+            uint32_t count = aymo_(rs_lin_process)(&rs, 256, aymo_in, aymo_out);
+            for (uint32_t i = 0; i < count; ++i) {
+                int16_t nuked_out[4];
+                OPL3_Generate4ChResampled(&nuked_chip, nuked_out);
+                for (int c = 0; c < 4; ++c) {
+                    mismatches += (uint32_t)(nuked_out[c] != aymo_out[(i * 4) + c]);
+                }
+            }
+        }
+        printf_s("rs_lin %u Hz: ratio %d, mismatches %u\n", rate, (int)rs.rateratio, mismatches);
+        assert(!mismatches);
+    }
+}
+
+
+void rhythm_test(void)
+{
+    // Rhythm key bits of register 0xBD, one drum at a time, then all together
+    static const uint8_t keys[] = { 0x10, 0x08, 0x04, 0x02, 0x01, 0x1F };
+    static int16_t aymo_out[256 * 4];
+
+    for (uint8_t key : keys) {
+        aymo_(init)(&aymo_chip);
+        OPL3_Reset(&nuked_chip, 49716);
+
+        // Rhythm channels 6..8 with feedback, panned to different outputs
+        static const uint16_t regs[][2] = {
+            { 0x105, 0x01 },
+            { 0x030, 0x01 }, { 0x033, 0x02 }, { 0x050, 0x00 }, { 0x053, 0x00 },
+            { 0x070, 0xF3 }, { 0x073, 0xF4 }, { 0x090, 0x15 }, { 0x093, 0x25 },
+            { 0x031, 0x02 }, { 0x034, 0x01 }, { 0x051, 0x04 }, { 0x054, 0x02 },
+            { 0x071, 0xF2 }, { 0x074, 0xF3 }, { 0x091, 0x26 }, { 0x094, 0x17 },
+            { 0x032, 0x03 }, { 0x035, 0x01 }, { 0x052, 0x00 }, { 0x055, 0x03 },
+            { 0x072, 0xF4 }, { 0x075, 0xF1 }, { 0x092, 0x35 }, { 0x095, 0x16 },
+            { 0x0F0, 0x01 }, { 0x0F5, 0x02 },
+            { 0x0C6, 0xFE }, { 0x0A6, 0x6B }, { 0x0B6, 0x09 },
+            { 0x0C7, 0x30 }, { 0x0A7, 0x41 }, { 0x0B7, 0x0A },
+            { 0x0C8, 0xF0 }, { 0x0A8, 0x57 }, { 0x0B8, 0x0E }
+        };
+        for (const auto& reg : regs) {
+            OPL3_WriteReg(&nuked_chip, reg[0], (uint8_t)reg[1]);
+            aymo_(write)(&aymo_chip, reg[0], (uint8_t)reg[1]);
+        }
+
+        // Key on, key off, then rhythm mode off
+        static const uint32_t blocks[] = { 32, 32, 8 };
+        const uint8_t bds[] = { (uint8_t)(0x20 | key), 0x20, 0x00 };
+
+        uint32_t mismatches = 0;
+        for (int phase = 0; phase < 3; ++phase) {
+            OPL3_WriteReg(&nuked_chip, 0xBD, bds[phase]);
+            aymo_(write)(&aymo_chip, 0xBD, bds[phase]);
+
+            for (uint32_t block = 0; block < blocks[phase]; ++block) {
+                aymo_(generate_i16x4)(&aymo_chip, 256, aymo_out);
+                for (uint32_t i = 0; i < 256; ++i) {
+                    int16_t nuked_out[4];
+                    OPL3_Generate4Ch(&nuked_chip, nuked_out);
+                    for (int c = 0; c < 4; ++c) {
+                        mismatches += (uint32_t)(nuked_out[c] != aymo_out[(i * 4) + c]);
+                    }
+                }
+            }
+        }
+        printf_s("rhythm 0x%02X: mismatches %u\n", (unsigned)key, mismatches);
+        assert(!mismatches);
+    }
+}
+
+
+// Writes six sustained channels with full feedback, also into Nuked if given
+static void test_channels_write(struct aymo_(chip)* chip, opl3_chip* nuked)
+{
+    static const uint8_t ops[6] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0A };
+    static const uint16_t fnums[6] = { 0x16B, 0x181, 0x198, 0x1B0, 0x1CA, 0x1E5 };
+
+    auto write = [chip, nuked](uint16_t address, uint8_t value) {
+        if (nuked) {
+            OPL3_WriteReg(nuked, address, value);
+        }
+        aymo_(write)(chip, address, value);
+    };
+    write(0x105, 0x01);
+    for (int ch = 0; ch < 6; ++ch) {
+        for (int op = 0; op < 2; ++op) {
+            uint16_t slot = (uint16_t)(ops[ch] + (op * 3));
+            write((uint16_t)(0x20 + slot), (uint8_t)(0x20 | (ch + op + 1)));
+            write((uint16_t)(0x40 + slot), (uint8_t)(op ? 0x00 : 0x08));
+            write((uint16_t)(0x60 + slot), 0xF2);
+            write((uint16_t)(0x80 + slot), 0x03);
+            write((uint16_t)(0xE0 + slot), (uint8_t)(op ? 0x00 : (ch % 4)));
+        }
+        write((uint16_t)(0xC0 + ch), (uint8_t)((ch & 1) ? 0xFE : 0x3E));
+        write((uint16_t)(0xA0 + ch), (uint8_t)(fnums[ch] & 0xFF));
+        write((uint16_t)(0xB0 + ch), (uint8_t)(0x20 | (4 << 2) | (fnums[ch] >> 8)));
+    }
+}
+
+
+void mute_solo_test(void)
+{
+    // Compared against Nuked while unmasked
+    static int16_t aymo_out[100 * 4];
+
+    aymo_(init)(&aymo_chip);
+    OPL3_Reset(&nuked_chip, 49716);
+    test_channels_write(&aymo_chip, &nuked_chip);
+
+    // Mute and solo masks, by Channel_2xOP index
+    static const uint32_t masks[][2] = {
+        { 0x000, 0x000 }, { 0x001, 0x000 }, { 0x000, 0x000 }, { 0x00A, 0x000 },
+        { 0x000, 0x000 }, { 0x000, 0x004 }, { 0x000, 0x000 }, { 0x03F, 0x000 },
+        { 0x000, 0x000 }, { 0x010, 0x030 }, { 0x000, 0x000 }
+    };
+
+    uint32_t mismatches = 0;
+    for (const auto& mask : masks) {
+        aymo_(og_set_mute_solo)(&aymo_chip, mask[0], mask[1]);
+
+        for (uint32_t block = 0; block < 37; ++block) {
+            aymo_(generate_i16x4)(&aymo_chip, 100, aymo_out);
+            for (uint32_t i = 0; i < 100; ++i) {
+                int16_t nuked_out[4];
+                OPL3_Generate4Ch(&nuked_chip, nuked_out);
+                if (!mask[0] && !mask[1]) {
+                    // Outputs B and D lag one tick, so they still carry the masked tick
+                    int c_step = ((block || i) ? 1 : 2);
+                    for (int c = 0; c < 4; c += c_step) {
+                        mismatches += (uint32_t)(nuked_out[c] != aymo_out[(i * 4) + c]);
+                    }
+                }
+            }
+        }
+    }
+    printf_s("mute_solo: mismatches %u\n", mismatches);
+    assert(!mismatches);
+}
+
+
+void ng_skip_test(void)
+{
+    // Random 23-bit seeds and step counts, plus a few edge counts
+    static const uint64_t edges[] = { 0, 1, 8, 9, 10, 22, 23, 24, 36, 1000000 };
+    uint32_t mismatches = 0;
+    uint32_t checks = 0;
+    srand(1);
+
+    for (int trial = 0; trial < 1000; ++trial) {
+        uint32_t seed = ((((uint32_t)rand() << 16) ^ (uint32_t)rand()) & 0x7FFFFFU);
+        uint64_t steps = ((trial < 10) ? edges[trial] : ((uint64_t)rand() % 100000U));
+
+        // Reference single steps, as in Nuked
+        uint32_t noise = seed;
+        for (uint64_t i = 0; i < steps; ++i) {
+            uint32_t n_bit = (((noise >> 14) ^ noise) & 1U);
+            noise = ((noise >> 1) | (n_bit << 22));
+        }
+
+        aymo_(init)(&aymo_chip);
+        aymo_chip.ng_noise = seed;
+        aymo_(ng_skip)(&aymo_chip, steps);
+        mismatches += (uint32_t)(aymo_chip.ng_noise != noise);
+        ++checks;
+    }
+    printf_s("ng_skip: checks %u, mismatches %u\n", checks, mismatches);
+    assert(!mismatches);
+}
+
+
+void stems_test(void)
+{
+    // Channels 0..5 are mixed before any delayed slot, so A and C sum the stems
+    // of the same tick, while B and D sum those of the previous tick
+    static int16_t aymo_out[997 * 4];
+    static int16_t aymo_ych[AYMO_(CHANNEL_NUM) * 997];
+
+    aymo_(init)(&aymo_chip);
+    test_channels_write(&aymo_chip, NULL);
+
+    int32_t sum_prev[4] = { 0, 0, 0, 0 };
+    uint32_t mismatches = 0;
+    for (uint32_t block = 0; block < 20; ++block) {
+        aymo_(generate_i16x4_ch2x)(&aymo_chip, 997, aymo_out, aymo_ych);
+        for (uint32_t i = 0; i < 997; ++i) {
+            int32_t sum[4] = { 0, 0, 0, 0 };
+            for (int ch2x = 0; ch2x < AYMO_(CHANNEL_NUM); ++ch2x) {
+                int16_t stem = aymo_ych[(ch2x * 997) + i];
+                if (ch2x >= 6) {
+                    mismatches += (uint32_t)(stem != 0);
+                    continue;
+                }
+                // Channels pan to A and B, odd ones also to C and D
+                for (int c = 0; c < 4; ++c) {
+                    if ((c < 2) || (ch2x & 1)) {
+                        sum[c] += stem;
+                    }
+                }
+            }
+            mismatches += (uint32_t)(aymo_out[(i * 4) + 0] != clamp16(sum[0]));
+            mismatches += (uint32_t)(aymo_out[(i * 4) + 1] != clamp16(sum_prev[1]));
+            mismatches += (uint32_t)(aymo_out[(i * 4) + 2] != clamp16(sum[2]));
+            mismatches += (uint32_t)(aymo_out[(i * 4) + 3] != clamp16(sum_prev[3]));
+            for (int c = 0; c < 4; ++c) {
+                sum_prev[c] = sum[c];
+            }
+        }
+    }
+    printf_s("stems: mismatches %u\n", mismatches);
+    assert(!mismatches);
+}
+
+
+void meters_test(void)
+{
+    // Same render on two chips, one with stems and one with meters
+    static int16_t aymo_out[997 * 4];
+    static int16_t aymo_out2[997 * 4];
+    static int16_t aymo_ych[AYMO_(CHANNEL_NUM) * 997];
+    static struct aymo_(og_meters) meters;
+
+    aymo_(init)(&aymo_chip);
+    aymo_(init)(&aymo_chip2);
+    test_channels_write(&aymo_chip, NULL);
+    test_channels_write(&aymo_chip2, NULL);
+
+    uint32_t mismatches = 0;
+    for (uint32_t block = 0; block < 20; ++block) {
+        aymo_(generate_i16x4_ch2x)(&aymo_chip, 997, aymo_out, aymo_ych);
+        aymo_(generate_i16x4_meters)(&aymo_chip2, 997, aymo_out2, &meters);
+        mismatches += (uint32_t)(meters.count != 997);
+
+        for (int ch2x = 0; ch2x < AYMO_(CHANNEL_NUM); ++ch2x) {
+            uint64_t energy = 0;
+            uint16_t peak = 0;
+            for (uint32_t i = 0; i < 997; ++i) {
+                int32_t stem = aymo_ych[(ch2x * 997) + i];
+                energy += (uint64_t)(stem * stem);
+                if (peak < (uint16_t)abs(stem)) {
+                    peak = (uint16_t)abs(stem);
+                }
+            }
+            mismatches += (uint32_t)(meters.energy[ch2x] != energy);
+            mismatches += (uint32_t)(meters.peak[ch2x] != peak);
+        }
+        for (uint32_t i = 0; i < (997 * 4); ++i) {
+            mismatches += (uint32_t)(aymo_out[i] != aymo_out2[i]);
+        }
+    }
+    printf_s("meters: mismatches %u\n", mismatches);
+    assert(!mismatches);
+}
+
+
+void mix_test(void)
+{
+    // Unity gain mixes unsaturated outputs into a non-empty bus, saturated afterwards
+    static int16_t aymo_out[997 * 4];
+    static int32_t mix_i32[997 * 4];
+    static float mix_f32[997 * 4];
+    static struct aymo_(chip) aymo_chip3;
+
+    aymo_(init)(&aymo_chip);
+    aymo_(init)(&aymo_chip2);
+    aymo_(init)(&aymo_chip3);
+    test_channels_write(&aymo_chip, NULL);
+    test_channels_write(&aymo_chip2, NULL);
+    test_channels_write(&aymo_chip3, NULL);
+
+    uint32_t mismatches = 0;
+    for (uint32_t block = 0; block < 20; ++block) {
+        for (uint32_t i = 0; i < (997 * 4); ++i) {
+            mix_i32[i] = (int32_t)(i % 7) - 3;
+            mix_f32[i] = (float)((int32_t)(i % 7) - 3);
+        }
+        aymo_(generate_i16x4)(&aymo_chip, 997, aymo_out);
+        aymo_(generate_mix_i32x4)(&aymo_chip2, 997, mix_i32, 0x10000);
+        aymo_(generate_mix_f32x4)(&aymo_chip3, 997, mix_f32, 0x10000);
+
+        for (uint32_t i = 0; i < (997 * 4); ++i) {
+            int32_t bias = ((int32_t)(i % 7) - 3);
+            int32_t out_i32 = (mix_i32[i] - bias);
+            int32_t out_f32 = (int32_t)((mix_f32[i] - (float)bias) * 32768.f);
+            mismatches += (uint32_t)(aymo_out[i] != clamp16(out_i32));
+            mismatches += (uint32_t)(aymo_out[i] != clamp16(out_f32));
+        }
+    }
+    printf_s("mix: mismatches %u\n", mismatches);
+    assert(!mismatches);
+}
+
+
+void convert_test(void)
+{
+    // Random samples with full scale extremes, and odd counts for the scalar tails
+    static int16_t x[1003 * 4];
+    static int16_t y16[1003 * 4];
+    static int32_t y32[1003 * 4];
+    static uint8_t y24[1003 * 4 * 3];
+    static float yf32[1003 * 4];
+    const uint32_t count = (1003 * 4);
+    const uint32_t frames = 1003;
+
+    srand(1);
+    for (uint32_t i = 0; i < count; ++i) {
+        x[i] = (int16_t)(((uint32_t)rand() << 4) ^ (uint32_t)rand());
+    }
+    x[0] = INT16_MIN;
+    x[1] = INT16_MAX;
+    x[2] = INT16_MAX;
+    x[4] = INT16_MIN;
+    x[6] = INT16_MIN;
+
+    uint32_t mismatches = 0;
+
+    aymo_(convert_i16_i32)(count, x, y32);
+    aymo_(convert_i16_i24)(count, x, y24);
+    aymo_(convert_i16_f32)(count, x, yf32);
+    for (uint32_t i = 0; i < count; ++i) {
+        mismatches += (uint32_t)(y32[i] != ((int32_t)x[i] * 65536));
+        int16_t x24 = (int16_t)(uint16_t)(y24[(i * 3) + 1] | (y24[(i * 3) + 2] << 8));
+        mismatches += (uint32_t)((y24[i * 3] != 0) || (x24 != x[i]));
+        mismatches += (uint32_t)(((int32_t)(yf32[i] * 32768.f) != x[i]) || (yf32[i] < -1.f) || (yf32[i] >= 1.f));
+    }
+
+    // Downmix, then again in place
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass) {
+            for (uint32_t i = 0; i < count; ++i) {
+                y16[i] = x[i];
+            }
+            aymo_(convert_i16x4_i16x2)(frames, y16, y16);
+        }
+        else {
+            aymo_(convert_i16x4_i16x2)(frames, x, y16);
+        }
+        for (uint32_t i = 0; i < frames; ++i) {
+            int16_t l = clamp16(x[(i * 4) + 0] + x[(i * 4) + 2]);
+            int16_t r = clamp16(x[(i * 4) + 1] + x[(i * 4) + 3]);
+            mismatches += (uint32_t)((y16[(i * 2) + 0] != l) || (y16[(i * 2) + 1] != r));
+        }
+    }
+    printf_s("convert: mismatches %u\n", mismatches);
+    assert(!mismatches);
+}
+
+
+void taps_test(void)
+{
+    // Native, linear and polyphase taps, each checked against a separate render
+    static const uint32_t rates[] = { AYMO_(SAMPLE_RATE), 44100, 48000, 96000 };
+    static int16_t tap_out[4][((997 * 20 * 2) + 2) * 4];
+    static int16_t ref_out[((997 * 20 * 2) + 2) * 4];
+    static int16_t aymo_out[997 * 4];
+    static struct aymo_(rs_lin) lin[2];
+    static struct aymo_(rs_poly) poly[4];
+    struct aymo_(rs_tap) taps[4];
+
+    aymo_(rs_lin_init)(&lin[0], rates[1]);
+    aymo_(rs_poly_init)(&poly[0], rates[2]);
+    aymo_(rs_poly_init)(&poly[1], rates[3]);
+    for (int t = 0; t < 4; ++t) {
+        taps[t].poly = ((t >= 2) ? &poly[t - 2] : NULL);
+        taps[t].lin = ((t == 1) ? &lin[0] : NULL);
+        taps[t].y = tap_out[t];
+        taps[t].count = 0;
+    }
+    aymo_(init)(&aymo_chip);
+    test_channels_write(&aymo_chip, NULL);
+    for (uint32_t block = 0; block < 20; ++block) {
+        aymo_(generate_i16x4_taps)(&aymo_chip, 997, taps, 4);
+    }
+
+    uint32_t mismatches = 0;
+    for (int t = 0; t < 4; ++t) {
+        aymo_(rs_lin_init)(&lin[1], rates[1]);
+        aymo_(rs_poly_init)(&poly[2], rates[2]);
+        aymo_(rs_poly_init)(&poly[3], rates[3]);
+        aymo_(init)(&aymo_chip2);
+        test_channels_write(&aymo_chip2, NULL);
+
+        uint32_t count = 0;
+        for (uint32_t block = 0; block < 20; ++block) {
+            aymo_(generate_i16x4)(&aymo_chip2, 997, aymo_out);
+            int16_t* y = &ref_out[count * 4];
+            if (t >= 2) {
+                count += aymo_(rs_poly_process)(&poly[t], 997, aymo_out, y);
+            }
+            else if (t == 1) {
+                count += aymo_(rs_lin_process)(&lin[1], 997, aymo_out, y);
+            }
+            else {
+                for (uint32_t i = 0; i < (997 * 4); ++i) {
+                    y[i] = aymo_out[i];
+                }
+                count += 997;
+            }
+        }
+        mismatches += (uint32_t)(taps[t].count != count);
+        for (uint32_t i = 0; (i < (count * 4)) && (i < (taps[t].count * 4)); ++i) {
+            mismatches += (uint32_t)(tap_out[t][i] != ref_out[i]);
+        }
+        printf_s("taps %u Hz: frames %u, reference %u\n", rates[t], taps[t].count, count);
+    }
+    printf_s("taps: mismatches %u\n", mismatches);
+    assert(!mismatches);
+}
+
+
 void silence_benchmark(void)
 {
     int64_t time_ms_aymo = 0;
@@ -281,6 +830,21 @@ void silence_benchmark(void)
 }
 
 
+void footprint_report(void)
+{
+    const size_t line = 64;
+    const size_t hot = offsetof(struct aymo_(chip), sg_cold);
+    const size_t total = sizeof(struct aymo_(chip));
+
+    printf_s("slot_group: %zu bytes\n", sizeof(struct aymo_(slot_group)));
+    printf_s("slot_group_cold: %zu bytes\n", sizeof(struct aymo_(slot_group_cold)));
+    printf_s("ch2x_group: %zu bytes\n", sizeof(struct aymo_(ch2x_group)));
+    printf_s("chip: %zu bytes, %zu cache lines\n", total, ((total + line - 1) / line));
+    printf_s("chip hot: %zu bytes, %zu cache lines per tick\n", hot, ((hot + line - 1) / line));
+    printf_s("chip cold: %zu bytes\n", (total - hot));
+}
+
+
 void imf_test_simple(void)
 {
     static const uint8_t imf_buffer[] = {
@@ -341,19 +905,12 @@ void imf_test_simple(void)
 
 void imf_test_file(void)
 {
-    std::string imf_buffer;
-    {
-        std::string path = "IMF\\23 - Award Ceremony.wlf";
-        //std::string path = "adlib_38.imf.wlf";
-        std::ifstream ifs(path, std::ios::binary);
-        std::stringstream ss;
-        ss << ifs.rdbuf();
-        imf_buffer = ss.str();
-    }
+    mapped_file imf_file("IMF\\23 - Award Ceremony.wlf");
+    //mapped_file imf_file("adlib_38.imf.wlf");
     static struct imf_status imf_status;
     imf_init(&imf_status, (uint32_t)imf_rate_wolfenstein_3d, (uint32_t)AYMO_(SAMPLE_RATE));
-    uint8_t imf_type = imf_guess_type(imf_buffer.c_str(), imf_buffer.size());
-    imf_load(&imf_status, imf_buffer.c_str(), imf_buffer.size(), imf_type);
+    uint8_t imf_type = imf_guess_type(imf_file.data(), imf_file.size());
+    imf_load(&imf_status, imf_file.data(), imf_file.size(), imf_type);
     std::ofstream ofs("file.raw", std::ios::binary);
 
     aymo_(init)(&aymo_chip);
@@ -381,18 +938,11 @@ void imf_test_file(void)
 
 void regdump_test_file(void)
 {
-    std::string regdump_buffer;
-    {
-        std::string path = "regdumpopl.bin";
-        std::ifstream ifs(path, std::ios::binary);
-        std::stringstream ss;
-        ss << ifs.rdbuf();
-        regdump_buffer = ss.str();
-    }
+    mapped_file regdump_file("regdumpopl.bin");
     static struct regdump_status regdump_status;
     regdump_init(&regdump_status);
-    uint8_t imf_type = imf_guess_type(regdump_buffer.c_str(), regdump_buffer.size());
-    regdump_load(&regdump_status, regdump_buffer.c_str(), regdump_buffer.size());
+    uint8_t imf_type = imf_guess_type(regdump_file.data(), regdump_file.size());
+    regdump_load(&regdump_status, regdump_file.data(), regdump_file.size());
     std::ofstream ofs("file.raw", std::ios::binary);
 
     aymo_(init)(&aymo_chip);
@@ -420,22 +970,255 @@ void regdump_test_file(void)
 }
 
 
-void file_benchmark(void)
+void regdump_test_stream(void)
+{
+    static struct regdump_stream regdump_stream;
+    regdump_stream_init(&regdump_stream, 0);  // standard input
+    std::ofstream ofs("file.raw", std::ios::binary);
+
+    aymo_(init)(&aymo_chip);
+
+    struct regdump_cmd cmd = { 0, 0, 1 };
+    while (cmd.delaying < 2) {
+        cmd = regdump_stream_opl_tick(&regdump_stream);
+        if (cmd.address) {
+            aymo_(write)(&aymo_chip, cmd.address, cmd.value);
+        }
+        aymo_(tick)(&aymo_chip);
+        ofs.write(reinterpret_cast<const char*>(&aymo_chip.og_out_a), sizeof(int16_t));
+    }
+    if (regdump_stream.error) {
+        printf_s("regdump_test_stream: read error %d\n", regdump_stream.error);
+    }
+}
+
+
+// Random register writes and delays, as a regdump capture
+static std::vector<uint8_t> test_regdump_events(uint32_t count)
 {
-    std::string regdump_buffer;
+    std::vector<uint8_t> data;
+    data.reserve((size_t)count * 3);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (rand() % 4) {
+            data.push_back((uint8_t)(rand() & 1));
+            data.push_back((uint8_t)rand());
+            data.push_back((uint8_t)rand());
+        }
+        else {
+            // Mostly short delays, including null ones
+            uint32_t delay = ((rand() % 8) ? (uint32_t)(rand() % 4) : (uint32_t)(rand() % 1000));
+            data.push_back((uint8_t)(0x80 | (delay >> 16)));
+            data.push_back((uint8_t)(delay >> 8));
+            data.push_back((uint8_t)delay);
+        }
+    }
+    return data;
+}
+
+
+void regdump_stream_chunks_test(void)
+{
+    // Events fed through a pipe in pieces of any size, so that they straddle the reads
+    srand(1);
+    std::vector<uint8_t> data = test_regdump_events(100000);
+    data.push_back(0x00);  // truncated trailing event
+    data.push_back(0x20);
+
+    int fds[2];
+    if (pipe_open(fds)) {
+        printf_s("regdump_stream_chunks_test: pipe failed\n");
+        return;
+    }
+    static struct regdump_stream regdump_stream;
+    regdump_stream_init(&regdump_stream, fds[0]);
+    static struct regdump_status regdump_status;
+    regdump_init(&regdump_status);
+    regdump_load(&regdump_status, data.data(), data.size());
+
+    size_t fed = 0;
+    uint32_t ticks = 0;
+    uint32_t mismatches = 0;
+    struct regdump_cmd cmd = { 0, 0, 1 };
+    while (cmd.delaying < 2) {
+        // Feed the pipe only when the stream is about to read it, so that it never blocks
+        const struct regdump_status* status = &regdump_stream.status;
+        if ((status->delay <= 1) && (status->index >= status->length) && (fed < data.size())) {
+            size_t piece = (3 + ((size_t)rand() % 1500));
+            if (piece > (data.size() - fed)) {
+                piece = (data.size() - fed);
+            }
+            if (pipe_write(fds[1], &data[fed], piece) != (long)piece) {
+                printf_s("regdump_stream_chunks_test: pipe write failed\n");
+                break;
+            }
+            fed += piece;
+            if (fed >= data.size()) {
+                pipe_close(fds[1]);
+            }
+        }
+
+        struct regdump_cmd stream_cmd = regdump_stream_opl_tick(&regdump_stream);
+        cmd = regdump_opl_tick(&regdump_status);
+        mismatches += (uint32_t)((stream_cmd.address != cmd.address) ||
+                                 (stream_cmd.value != cmd.value) ||
+                                 (stream_cmd.delaying != cmd.delaying));
+        ++ticks;
+    }
+    pipe_close(fds[0]);
+
+    printf_s("regdump_stream_chunks: ticks %u, mismatches %u, error %d\n",
+             ticks, mismatches, regdump_stream.error);
+    assert(!mismatches && !regdump_stream.error);
+}
+
+
+// Checks the seek index and write windows of a scan, against the ticks when events were played
+template <typename scan_result>
+static uint32_t test_scan_check(
+    const scan_result& scan,
+    const std::vector<uint64_t>& played,
+    const std::vector<uint8_t>& writes,
+    uint64_t duration
+)
+{
+    uint32_t mismatches = (uint32_t)(scan.duration != duration);
+    uint32_t seek_length = 0;
+    uint32_t window_writes = 0;
+    uint32_t window_writes_max = 0;
+
+    for (size_t i = 0; i < played.size(); ++i) {
+        while (played[i] >= ((uint64_t)seek_length * scan.seek_period)) {
+            if (seek_length < scan.seek_size) {
+                mismatches += (uint32_t)(scan.seek[seek_length] != (uint32_t)i);
+            }
+            seek_length++;
+            if (window_writes_max < window_writes) {
+                window_writes_max = window_writes;
+            }
+            window_writes = 0;
+        }
+        window_writes += writes[i];
+    }
+    if (window_writes_max < window_writes) {
+        window_writes_max = window_writes;
+    }
+    mismatches += (uint32_t)(scan.seek_length != seek_length);
+    mismatches += (uint32_t)(scan.window_writes_max != window_writes_max);
+    return mismatches;
+}
+
+
+void scan_test(void)
+{
+    // Scans checked against full playbacks, with a large and a small seek index
+    static const uint32_t seek_sizes[] = { 4096, 16 };
+    static uint32_t seek[4096];
+    uint32_t mismatches = 0;
+    srand(1);
+
+    std::vector<uint8_t> regdump_data = test_regdump_events(100000);
+    static struct regdump_status regdump_status;
+    regdump_init(&regdump_status);
+    regdump_load(&regdump_status, regdump_data.data(), regdump_data.size());
+    {
+        std::vector<uint64_t> played;
+        std::vector<uint8_t> writes;
+        uint64_t delay_sum = 0;
+        uint32_t delay_count = 0;
+        uint64_t tick = 0;
+
+        for (;; ++tick) {
+            uint32_t index = regdump_status.index;
+            struct regdump_cmd cmd = regdump_opl_tick(&regdump_status);
+            if (cmd.delaying >= 2) {
+                break;
+            }
+            if (regdump_status.index != index) {
+                const struct regdump_event* event = &regdump_status.events[index];
+                uint8_t is_write = (uint8_t)!(event->address_hi & 0x80);
+                played.push_back(tick);
+                writes.push_back(is_write);
+                if (!is_write) {
+                    delay_sum += (((uint32_t)(event->address_hi & 0x7F) << 16) |
+                                  ((uint32_t)event->address_lo << 8) | event->value);
+                    delay_count++;
+                }
+            }
+        }
+
+        for (uint32_t seek_size : seek_sizes) {
+            struct regdump_scan_result scan;
+            regdump_scan(&scan, &regdump_status, 1000, seek, seek_size);
+            mismatches += test_scan_check(scan, played, writes, tick);
+            mismatches += (uint32_t)(scan.delay_sum != delay_sum);
+            mismatches += (uint32_t)(scan.delay_count != delay_count);
+            mismatches += (uint32_t)(scan.write_count != (regdump_status.length - delay_count));
+        }
+        printf_s("regdump_scan: ticks %llu, mismatches %u\n", (unsigned long long)tick, mismatches);
+    }
+
+    std::vector<uint8_t> imf_data;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        uint32_t delay = ((rand() % 8) ? (uint32_t)(rand() % 4) : (uint32_t)(rand() % 50));
+        imf_data.push_back((uint8_t)((rand() % 16) ? rand() : 0x05));  // some virtual register writes
+        imf_data.push_back((uint8_t)rand());
+        imf_data.push_back((uint8_t)delay);
+        imf_data.push_back((uint8_t)(delay >> 8));
+    }
+    static struct imf_status imf_status;
+    imf_init(&imf_status, (uint32_t)imf_rate_default, (uint32_t)AYMO_(SAMPLE_RATE));
+    imf_load(&imf_status, imf_data.data(), imf_data.size(), 0);
     {
-        std::string path = "regdumpopl.bin";
-        //std::string path = "IMF\\16 - Zero Hour.wlf";
-        //std::string path = "adlib_38.imf.wlf";
-        std::ifstream ifs(path, std::ios::binary);
-        std::stringstream ss;
-        ss << ifs.rdbuf();
-        regdump_buffer = ss.str();
+        std::vector<uint64_t> played;
+        std::vector<uint8_t> writes;
+        uint64_t delay_sum = 0;
+        uint32_t delay_count = 0;
+        uint32_t write_count = 0;
+        uint64_t tick = 0;
+
+        for (;; ++tick) {
+            uint32_t index = imf_status.index;
+            struct imf_cmd cmd = imf_opl_tick(&imf_status);
+            if (cmd.delaying >= 2) {
+                break;
+            }
+            if (imf_status.index != index) {
+                const struct imf_event* event = &imf_status.events[index];
+                uint32_t delay = (((uint32_t)event->delay_hi << 8) | event->delay_lo);
+                uint8_t is_write = (uint8_t)(event->address_lo != 0x05);
+                played.push_back(tick);
+                writes.push_back(is_write);
+                delay_sum += delay;
+                delay_count += (uint32_t)(delay > 0);
+                write_count += is_write;
+            }
+        }
+
+        uint32_t imf_mismatches = 0;
+        for (uint32_t seek_size : seek_sizes) {
+            struct imf_scan_result scan;
+            imf_scan(&scan, &imf_status, 1000, seek, seek_size);
+            imf_mismatches += test_scan_check(scan, played, writes, tick);
+            imf_mismatches += (uint32_t)(scan.delay_sum != delay_sum);
+            imf_mismatches += (uint32_t)(scan.delay_count != delay_count);
+            imf_mismatches += (uint32_t)(scan.write_count != write_count);
+        }
+        printf_s("imf_scan: ticks %llu, mismatches %u\n", (unsigned long long)tick, imf_mismatches);
+        mismatches += imf_mismatches;
     }
+    assert(!mismatches);
+}
+
+
+void file_benchmark(void)
+{
+    mapped_file regdump_file("regdumpopl.bin");
+    //mapped_file regdump_file("IMF\\16 - Zero Hour.wlf");
+    //mapped_file regdump_file("adlib_38.imf.wlf");
     static struct regdump_status regdump_status;
     regdump_init(&regdump_status);
-    uint8_t imf_type = imf_guess_type(regdump_buffer.c_str(), regdump_buffer.size());
-    regdump_load(&regdump_status, regdump_buffer.c_str(), regdump_buffer.size());
+    uint8_t imf_type = imf_guess_type(regdump_file.data(), regdump_file.size());
+    regdump_load(&regdump_status, regdump_file.data(), regdump_file.size());
     std::ofstream ofs("file.raw", std::ios::binary);
 
     int64_t time_ms_aymo = 0;
@@ -492,6 +1275,73 @@ void file_benchmark(void)
 }
 
 
+void lofi_benchmark(void)
+{
+    mapped_file regdump_file("regdumpopl.bin");
+    static struct regdump_status regdump_status;
+    regdump_init(&regdump_status);
+    regdump_load(&regdump_status, regdump_file.data(), regdump_file.size());
+
+    std::vector<int16_t> exact_out;
+
+    for (uint8_t lofi = 0; lofi <= 3; ++lofi) {
+        std::vector<int16_t> aymo_out;
+        aymo_(init)(&aymo_chip);
+        aymo_(set_lofi)(&aymo_chip, lofi);
+        regdump_restart(&regdump_status);
+
+        auto time_start = std::chrono::steady_clock::now();
+
+        struct regdump_cmd cmd = { 0, 0, 1 };
+        while (cmd.delaying < 2) {
+            cmd = regdump_opl_tick(&regdump_status);
+            if (cmd.address) {
+                aymo_(write)(&aymo_chip, cmd.address, cmd.value);
+            }
+            aymo_(tick)(&aymo_chip);
+            aymo_out.push_back(aymo_chip.og_out_a);
+            aymo_out.push_back(aymo_chip.og_out_b);
+        }
+
+        auto time_end = std::chrono::steady_clock::now();
+        auto time_diff = (time_end - time_start);
+        auto time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(time_diff).count();
+
+        if (!lofi) {
+            exact_out = aymo_out;
+            printf_s("exact: %lld\n", (long long)time_ms);
+            continue;
+        }
+
+        // Sample error, and loudness error over blocks of 4096 samples
+        int max_error = 0;
+        double error_energy = 0;
+        double exact_energy = 0;
+        double max_block_db = 0;
+        for (size_t i = 0; i < aymo_out.size(); i += 4096) {
+            double block_exact = 0;
+            double block_lofi = 0;
+            for (size_t j = i; (j < (i + 4096)) && (j < aymo_out.size()); ++j) {
+                int error = std::abs(aymo_out[j] - exact_out[j]);
+                max_error = ((max_error < error) ? error : max_error);
+                error_energy += ((double)error * error);
+                block_exact += ((double)exact_out[j] * exact_out[j]);
+                block_lofi += ((double)aymo_out[j] * aymo_out[j]);
+            }
+            if ((block_exact > 0) && (block_lofi > 0)) {
+                double block_db = std::fabs(10 * std::log10(block_lofi / block_exact));
+                max_block_db = ((max_block_db < block_db) ? block_db : max_block_db);
+            }
+            exact_energy += block_exact;
+        }
+        double snr_db = ((error_energy > 0) ? (10 * std::log10(exact_energy / error_energy)) : 0);
+
+        printf_s("lofi %u: %lld, max error %d, snr %.1f dB, max block loudness error %.2f dB\n",
+                 (unsigned)lofi, (long long)time_ms, max_error, snr_db, max_block_db);
+    }
+}
+
+
 void test_vhsum(void)
 {
 #if defined(AYMO_ARCH_IS_X86_SSE41)
@@ -510,6 +1360,72 @@ void test_vhsum(void)
 }
 
 
+#if defined(AYMO_ARCH_IS_X86_SSE41) || defined(AYMO_ARCH_IS_X86_AVX2)
+static aymoi16_t shift_benchmark_x[256];
+static aymoi16_t shift_benchmark_n[256];
+
+// Fills the benchmark operands with random values within the given ranges
+static void shift_benchmark_fill(int x_min, int x_max, int n_min, int n_max)
+{
+    int16_t* x = (int16_t*)(void*)shift_benchmark_x;
+    int16_t* n = (int16_t*)(void*)shift_benchmark_n;
+    for (size_t i = 0; i < (sizeof(shift_benchmark_x) / (sizeof(int16_t))); ++i) {
+        x[i] = (int16_t)(x_min + (rand() % (x_max - x_min + 1)));
+        n[i] = (int16_t)(n_min + (rand() % (n_max - n_min + 1)));
+    }
+}
+
+// Times a 16-bit shift kernel on the benchmark operands
+#define SHIFT_BENCHMARK_LOOP(acc, time_ms, kernel) \
+    { \
+        auto time_start = std::chrono::steady_clock::now(); \
+        for (int r = 0; r < 200'000; ++r) { \
+            for (int i = 0; i < 256; ++i) { \
+                aymoi16_t x = shift_benchmark_x[i]; \
+                aymoi16_t n = shift_benchmark_n[i]; \
+                (void)x; \
+                (acc) = vxor((acc), (kernel)); \
+            } \
+        } \
+        auto time_end = std::chrono::steady_clock::now(); \
+        auto time_diff = (time_end - time_start); \
+        (time_ms) = std::chrono::duration_cast<std::chrono::milliseconds>(time_diff).count(); \
+    }
+
+// Compares a generic vs a specialized 16-bit shift kernel on the same operands
+#define SHIFT_BENCHMARK(name, generic, specialized) \
+    { \
+        aymoi16_t acc_generic = vsetz(), acc_specialized = vsetz(); \
+        int64_t time_ms_generic = 0, time_ms_specialized = 0; \
+        SHIFT_BENCHMARK_LOOP(acc_generic, time_ms_generic, generic); \
+        SHIFT_BENCHMARK_LOOP(acc_specialized, time_ms_specialized, specialized); \
+        int same = (vhsum(vcmpeq(acc_generic, acc_specialized)) == -AYMO_(SLOT_GROUP_LENGTH)); \
+        printf_s("%-16s generic: %5lld  specialized: %5lld  %s\n", (name), \
+                 (long long)time_ms_generic, (long long)time_ms_specialized, \
+                 (same ? "ok" : "MISMATCH")); \
+    }
+
+void shift_benchmark(void)
+{
+    // wg_update(): exp_out
+    shift_benchmark_fill(0x0800, 0x0FF4, 0, 15);
+    SHIFT_BENCHMARK("exp_out", vsrlv(x, n), vsrlvx12lt16(x, n));
+
+    // eg_update(): shift_lt12
+    shift_benchmark_fill(8, 14, 0, 15);
+    SHIFT_BENCHMARK("shift_lt12", vsrlv(x, n), vsrlvx4lt16(x, n));
+
+    // eg_update(): eg_inc_atk_ninc
+    shift_benchmark_fill(0, 0x01FF, 0, 3);
+    SHIFT_BENCHMARK("eg_inc_atk_ninc", vsrlv(x, vsub(vset1(4), n)), vsrl4subvlt4(x, n));
+
+    // eg_update(): eg_gen_mullo
+    shift_benchmark_fill(0, 0, 0, 3);
+    SHIFT_BENCHMARK("eg_gen_mullo", vsllv(vset1(1), vslli(n, 2)), vpow16lt4(n));
+}
+#endif  // AYMO_ARCH_IS_X86_SSE41 || AYMO_ARCH_IS_X86_AVX2
+
+
 int main(int argc, char* argv[])
 {
     (void)argc;
@@ -520,9 +1436,24 @@ int main(int argc, char* argv[])
     //imf_test_simple();
     //imf_test_file();
     regdump_test_file();
-
+    //regdump_test_stream();
+    //regdump_stream_chunks_test();
+    //scan_test();
+
+    //footprint_report();
+    //rs_lin_test();
+    //rhythm_test();
+    //mute_solo_test();
+    //ng_skip_test();
+    //stems_test();
+    //meters_test();
+    //mix_test();
+    //convert_test();
+    //taps_test();
     //silence_benchmark();
     //file_benchmark();
+    //lofi_benchmark();
+    //shift_benchmark();
 
     return EXIT_SUCCESS;
 }
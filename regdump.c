@@ -1,7 +1,18 @@
 #include "regdump.h"
 
 #include <assert.h>
+#include <errno.h>
 #include <stddef.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+    #define regdump_read(fd, buf, size)     _read((fd), (buf), (unsigned)(size))
+#else
+    #include <unistd.h>
+    #define regdump_read(fd, buf, size)     read((fd), (buf), (size))
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -88,6 +99,170 @@ const struct regdump_cmd regdump_opl_tick(
 }
 
 
+void regdump_stream_init(
+    struct regdump_stream* stream,
+    int fd
+)
+{
+    assert(stream);
+
+    regdump_init(&stream->status);
+    stream->status.events = (const struct regdump_event*)(const void*)&stream->chunks[0][0];
+    stream->fd = fd;
+    stream->current = 0;
+    stream->carry = 0;
+    stream->error = 0;
+    stream->eof = 0;
+
+#ifdef _WIN32
+    _setmode(fd, _O_BINARY);  // standard streams start in text mode
+#endif
+}
+
+
+static void regdump_stream_fill(
+    struct regdump_stream* stream
+)
+{
+    const uint8_t* prev = &stream->chunks[stream->current][0];
+    uint8_t* next = &stream->chunks[stream->current ^ 1][0];
+    size_t size = stream->carry;
+    long n;
+
+    // Move the straddling event bytes in front of the next chunk
+    memcpy(next, &prev[stream->status.length * sizeof(struct regdump_event)], size);
+
+    // Read at least a whole event, unless the stream ends
+    while (!stream->eof && (size < sizeof(struct regdump_event))) {
+        n = (long)regdump_read(stream->fd, &next[size], (REGDUMP_STREAM_CHUNK - size));
+        if (n > 0) {
+            size += (size_t)n;
+        }
+        else if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            if (n < 0) {
+                stream->error = errno;
+            }
+            stream->eof = 1;
+        }
+    }
+
+    stream->current ^= 1;
+    stream->status.events = (const struct regdump_event*)(const void*)next;
+    stream->status.length = (uint32_t)(size / sizeof(struct regdump_event));
+    stream->status.index = 0;
+    stream->carry = (uint32_t)(size % sizeof(struct regdump_event));
+}
+
+
+const struct regdump_cmd regdump_stream_opl_tick(
+    struct regdump_stream* stream
+)
+{
+    struct regdump_status* status;
+    assert(stream);
+
+    // Refill only when the next tick would fetch past the current chunk
+    status = &stream->status;
+    if ((status->delay <= 1) && (status->index >= status->length) && !stream->eof) {
+        regdump_stream_fill(stream);
+    }
+    return regdump_opl_tick(status);
+}
+
+
+// Pre-scans the loaded events for duration, statistics, and a coarse seek index
+// Blocks are classified branchless, and walked in order only across seek periods
+void regdump_scan(
+    struct regdump_scan_result* scan,
+    const struct regdump_status* status,
+    uint32_t seek_period,
+    uint32_t* seek,
+    uint32_t seek_size
+)
+{
+    const struct regdump_event* events;
+    const struct regdump_event* block;
+    uint32_t costs[REGDUMP_SCAN_BLOCK];
+    uint8_t writes[REGDUMP_SCAN_BLOCK];
+    uint64_t tick = 0;
+    uint64_t boundary = 0;
+    uint32_t window_writes = 0;
+    uint32_t base;
+    uint32_t n;
+    uint32_t i;
+    assert(scan);
+    assert(status);
+    assert(seek_period);
+
+    scan->duration = 0;
+    scan->delay_sum = 0;
+    scan->write_count = 0;
+    scan->delay_count = 0;
+    scan->window_writes_max = 0;
+    scan->seek_period = seek_period;
+    scan->seek = seek;
+    scan->seek_size = (seek ? seek_size : 0);
+    scan->seek_length = 0;
+    events = status->events;
+
+    for (base = 0; base < status->length; base += n) {
+        uint64_t block_delay = 0;
+        uint32_t block_cost = 0;
+        uint32_t block_writes = 0;
+        n = (status->length - base);
+        if (n > REGDUMP_SCAN_BLOCK) {
+            n = REGDUMP_SCAN_BLOCK;
+        }
+
+        block = &events[base];
+        for (i = 0; i < n; ++i) {
+            const struct regdump_event* event = &block[i];
+            uint32_t is_delay = (uint32_t)(event->address_hi >> 7);
+            uint32_t delay = ((((uint32_t)(event->address_hi & 0x7F) * 0x10000u) +
+                               ((uint32_t)event->address_lo * 0x100u) + event->value) & (0u - is_delay));
+            writes[i] = (uint8_t)(is_delay ^ 1);
+            costs[i] = (delay + (uint32_t)(delay == 0));  // writes and null delays take a tick
+            block_delay += delay;
+            block_cost += costs[i];
+            block_writes += writes[i];
+        }
+        scan->delay_sum += block_delay;
+        scan->write_count += block_writes;
+        scan->delay_count += (n - block_writes);
+
+        if ((tick + block_cost) <= boundary) {
+            tick += block_cost;
+            window_writes += block_writes;
+        }
+        else {
+            for (i = 0; i < n; ++i) {
+                while (tick >= boundary) {
+                    if (scan->seek_length < scan->seek_size) {
+                        seek[scan->seek_length] = (base + i);
+                    }
+                    scan->seek_length++;
+                    if (scan->window_writes_max < window_writes) {
+                        scan->window_writes_max = window_writes;
+                    }
+                    window_writes = 0;
+                    boundary += seek_period;
+                }
+                tick += costs[i];
+                window_writes += writes[i];
+            }
+        }
+    }
+
+    if (scan->window_writes_max < window_writes) {
+        scan->window_writes_max = window_writes;
+    }
+    scan->duration = tick;
+}
+
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
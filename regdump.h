@@ -8,6 +8,14 @@
 extern "C" {
 #endif
 
+#ifndef REGDUMP_STREAM_CHUNK
+#define REGDUMP_STREAM_CHUNK    (3 * 16384)
+#endif
+
+#ifndef REGDUMP_SCAN_BLOCK
+#define REGDUMP_SCAN_BLOCK      128
+#endif
+
 #pragma pack(push, 1)
 
 
@@ -26,6 +34,30 @@ struct regdump_status {
 };
 
 
+struct regdump_stream {
+    struct regdump_status status;  // events of the current chunk
+    uint8_t chunks[2][REGDUMP_STREAM_CHUNK];
+    int fd;
+    uint32_t current;  // chunk in use
+    uint32_t carry;  // bytes of an event straddling the next chunk
+    int error;  // errno of a failed read, or 0
+    uint8_t eof;  // also set on read error
+};
+
+
+struct regdump_scan_result {
+    uint64_t duration;  // OPL ticks until the end of stream, as played
+    uint64_t delay_sum;  // sum of the delay values
+    uint32_t write_count;
+    uint32_t delay_count;
+    uint32_t window_writes_max;  // most writes within a seek period
+    uint32_t seek_period;  // OPL ticks between seek index entries
+    uint32_t* seek;  // first event played at each seek period, or NULL
+    uint32_t seek_size;  // seek index capacity
+    uint32_t seek_length;  // seek index entries, even beyond capacity
+};
+
+
 struct regdump_cmd {
     uint16_t address;
     uint8_t value;
@@ -51,6 +83,23 @@ const struct regdump_cmd regdump_opl_tick(
     struct regdump_status* status
 );
 
+void regdump_scan(
+    struct regdump_scan_result* scan,
+    const struct regdump_status* status,
+    uint32_t seek_period,
+    uint32_t* seek,
+    uint32_t seek_size
+);
+
+void regdump_stream_init(
+    struct regdump_stream* stream,
+    int fd
+);
+
+const struct regdump_cmd regdump_stream_opl_tick(
+    struct regdump_stream* stream
+);
+
 
 #pragma pack(pop)
 